@@ -0,0 +1,210 @@
+#!/usr/bin/perl
+
+use strict;
+use warnings;
+use Getopt::Std;
+use JSON::PP;
+use Time::HiRes qw(time);
+use Cwd qw(abs_path);
+
+# benchmark.pl
+#
+# runs the CORE tests of regression suites repeatedly, records run time,
+# peak memory, solver calls and strategy iterations and compares them to
+# a baseline
+
+$main::VERSION = 0.1;
+$Getopt::Std::STANDARD_HELP_VERSION = 1;
+
+my $gnu_time = "/usr/bin/time";
+
+sub load($) {
+  my ($fname) = @_;
+
+  open FILE, "<$fname";
+  my @data = grep { !/^\/\// } <FILE>;
+  close FILE;
+
+  chomp @data;
+  return @data;
+}
+
+sub median(@) {
+  my @sorted = sort { $a <=> $b } @_;
+  return $sorted[int((scalar @sorted) / 2)];
+}
+
+# total count of a counter of the profile written by --profile-json
+sub profile_count($$) {
+  my ($profile, $counter) = @_;
+  return 0 unless(defined($profile) && defined($profile->{$counter}));
+  return $profile->{$counter}->{count};
+}
+
+# the FLAGS of the Makefile of a suite, which are passed to all its tests
+sub suite_flags($) {
+  my ($suite) = @_;
+  my %vars;
+  open(my $fh, "<", "$suite/Makefile") || return "";
+  while(my $line = <$fh>) {
+    $vars{$1} = $2 if($line =~ /^(\w+)\s*=\s*(.*?)\s*$/);
+  }
+  close($fh);
+  my $flags = defined($vars{FLAGS}) ? $vars{FLAGS} : "";
+  $flags =~ s/\$\((\w+)\)/defined($vars{$1}) ? $vars{$1} : ""/ge;
+  return $flags;
+}
+
+# runs a single test and returns time, peak memory (kB), solver calls and
+# strategy iterations
+sub run($$$$) {
+  my ($dir, $cmd, $options, $input) = @_;
+  my $profile_file = "benchmark_profile.json";
+  my $time_file = "benchmark_time.txt";
+  my $cmdline = "$cmd $options --profile-json $profile_file '$input'";
+  my $has_gnu_time = -x $gnu_time;
+  $cmdline = "$gnu_time -f '%e %M' -o $time_file $cmdline" if($has_gnu_time);
+
+  my $start = time();
+  system("bash", "-c", "cd '$dir' ; $cmdline >/dev/null 2>&1");
+  my $wall_time = time() - $start;
+  my $signal_num = $? & 127;
+  if($signal_num == 2) {
+    print "\nProgram under test interrupted; stopping\n";
+    exit 1;
+  }
+
+  my $memory = 0;
+  if($has_gnu_time && open(my $fh, "<", "$dir/$time_file")) {
+    while(my $line = <$fh>) {
+      if($line =~ /^([0-9.]+) ([0-9]+)$/) {
+        $wall_time = $1;
+        $memory = $2;
+      }
+    }
+    close($fh);
+  }
+
+  my $profile;
+  if(open(my $fh, "<", "$dir/$profile_file")) {
+    local $/ = undef;
+    my $json = <$fh>;
+    close($fh);
+    $profile = eval { decode_json($json) };
+  }
+  unlink("$dir/$profile_file", "$dir/$time_file");
+
+  return ($wall_time, $memory,
+          profile_count($profile, "solver_calls"),
+          profile_count($profile, "strategy_iterations"));
+}
+
+sub load_results($) {
+  my ($fname) = @_;
+  my %results;
+  foreach my $line (load($fname)) {
+    my ($name, @values) = split(/\t/, $line);
+    $results{$name} = \@values;
+  }
+  return %results;
+}
+
+sub main::VERSION_MESSAGE($$$$) {
+  my ($fh, $getopt, $vers, $opts) = @_;
+  print {$fh} << "EOF";
+benchmark.pl version $vers -- benchmark 2LS on regression suites
+EOF
+}
+
+sub main::HELP_MESSAGE($$$$) {
+  my ($fh, $getopt, $vers, $opts) = @_;
+  print {$fh} << "EOF";
+Usage: benchmark.pl -c CMD [OPTIONS] SUITES ...
+  runs the CORE tests of the given regression suites (directories) with the
+  FLAGS of the Makefile of the suite
+  -c CMD     run tests on CMD - required option
+  -r <num>   number of repetitions of each test (default: 3), the median
+             time is taken
+  -b <file>  baseline file (default: benchmark.baseline)
+  -u         write the results to the baseline file
+  -t <num>   slowdown threshold in percent (default: 20)
+  -m <sec>   ignore slowdowns of tests faster than this (default: 0.5)
+  -h         show this help and exit
+The results contain for each test the wall time (s), peak memory (kB, if
+$gnu_time is available), the number of solver calls and the number of
+strategy iterations. The exit code is 1 if a test is slower than in the
+baseline by more than the threshold.
+EOF
+}
+
+our ($opt_b, $opt_c, $opt_h, $opt_m, $opt_r, $opt_t, $opt_u);
+if(!getopts('b:c:hm:r:t:u') || !defined($opt_c) || $opt_h || !@ARGV) {
+  main::HELP_MESSAGE(\*STDOUT, "", $main::VERSION, "");
+  exit 1;
+}
+my $repetitions = defined($opt_r) ? $opt_r : 3;
+my $baseline_file = defined($opt_b) ? $opt_b : "benchmark.baseline";
+my $threshold = defined($opt_t) ? $opt_t : 20;
+my $min_time = defined($opt_m) ? $opt_m : 0.5;
+
+# the command is run from the test directories
+my ($cmd, $cmd_options) = split(/ /, $opt_c, 2);
+$cmd = abs_path($cmd) if(-e $cmd);
+$cmd .= " $cmd_options" if(defined($cmd_options));
+
+my %baseline;
+%baseline = load_results($baseline_file) if(-e $baseline_file);
+my %results;
+my $slowdowns = 0;
+
+printf("%-40s %9s %9s %9s %9s\n",
+       "test", "time", "memory", "calls", "iters");
+foreach my $suite (@ARGV) {
+  opendir(my $dh, $suite) || die "Cannot open '$suite': $!";
+  my @tests = sort grep { !/^\./ && -f "$suite/$_/test.desc" } readdir $dh;
+  closedir($dh);
+  my $flags = suite_flags($suite);
+
+  foreach my $test (@tests) {
+    my ($level, $input, $options) = load("$suite/$test/test.desc");
+    next unless($level eq "CORE");
+    my $name = "$suite/$test";
+
+    my (@times, $memory, $calls, $iterations);
+    for(my $i = 0; $i < $repetitions; $i++) {
+      my ($t, $m);
+      ($t, $m, $calls, $iterations) =
+        run("$suite/$test", $cmd, "$flags $options", $input);
+      push @times, $t;
+      $memory = $m if(!defined($memory) || $m > $memory);
+    }
+    my $time = median(@times);
+    $results{$name} = [$time, $memory, $calls, $iterations];
+
+    my $note = "";
+    if(defined($baseline{$name})) {
+      my $base_time = $baseline{$name}->[0];
+      if($time > $min_time && $time > $base_time * (1 + $threshold / 100)) {
+        $note = sprintf(" SLOWDOWN (baseline %.2fs)", $base_time);
+        $slowdowns++;
+      }
+    }
+    printf("%-40s %9.2f %9d %9d %9d%s\n",
+           $name, $time, $memory, $calls, $iterations, $note);
+  }
+}
+
+if($opt_u) {
+  open(my $fh, ">", $baseline_file) || die "Cannot write '$baseline_file': $!";
+  foreach my $name (sort keys %results) {
+    print $fh join("\t", $name, @{$results{$name}}) . "\n";
+  }
+  close($fh);
+  print "Baseline written to $baseline_file\n";
+}
+
+if($slowdowns) {
+  print "$slowdowns test(s) slower than the baseline\n";
+  exit 1;
+}
+exit 0;
@@ -0,0 +1,26 @@
+#include <assert.h>
+#include <stdlib.h>
+
+extern int __VERIFIER_nondet_int();
+
+struct node
+{
+  int val;
+  struct node *next;
+};
+
+void main()
+{
+  struct node *list=NULL;
+  int n=0;
+  while(__VERIFIER_nondet_int() && n<10)
+  {
+    struct node *p=malloc(sizeof(struct node));
+    p->val=n;
+    p->next=list;
+    list=p;
+    n++;
+  }
+
+  assert(n>=0 && n<=10);
+}
@@ -0,0 +1,31 @@
+#include <assert.h>
+
+struct node
+{
+  int x;
+  struct node *n;
+};
+
+extern int __VERIFIER_nondet_int();
+
+void main()
+{
+  struct node a, b, c;
+  a.x=1;
+  b.x=2;
+  c.x=3;
+
+  struct node *p=&a;
+  while(__VERIFIER_nondet_int())
+  {
+    int k=__VERIFIER_nondet_int();
+    if(k==0)
+      p=&a;
+    else if(k==1)
+      p=&b;
+    else
+      p=&c;
+  }
+
+  assert(p->x>=1 && p->x<=3);
+}
@@ -0,0 +1,18 @@
+int clamp(int x)
+{
+  if(x<0)
+    return 0;
+  if(x>100)
+    return 100;
+  return x;
+}
+
+void main()
+{
+  int a=clamp(-5);
+  int b=clamp(50);
+  int c=clamp(200);
+  assert(a>=0 && a<=100);
+  assert(b>=0 && b<=100);
+  assert(c>=0 && c<=100);
+}
@@ -0,0 +1,16 @@
+int clamp(int x)
+{
+  if(x<0)
+    return 0;
+  if(x>100)
+    return 100;
+  return x;
+}
+
+void main()
+{
+  int a=clamp(-5);
+  int b=clamp(50);
+  int c=clamp(200);
+  assert(a==0);
+}
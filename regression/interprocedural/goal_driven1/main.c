@@ -0,0 +1,33 @@
+int g;
+
+int inc(int x)
+{
+  return x+1;
+}
+
+void set_g()
+{
+  g=3;
+}
+
+void unrelated()
+{
+  int y=0;
+  while(y<10)
+    y++;
+  assert(y==10);
+}
+
+void check(int x)
+{
+  assert(x>0);
+  assert(g==3);
+}
+
+void main()
+{
+  int x=inc(1);
+  set_g();
+  unrelated();
+  check(x);
+}
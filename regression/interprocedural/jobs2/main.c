@@ -0,0 +1,25 @@
+int foo(int x)
+{
+  int r=x;
+  if(r>10)
+    r=10;
+  assert(r<=10);
+  return r;
+}
+
+int bar(int x)
+{
+  int r=x;
+  if(r<0)
+    r=0;
+  assert(r>=0);
+  return r;
+}
+
+void main()
+{
+  int x;
+  int y=foo(x)+bar(x);
+  assert(y<=20);
+  assert(y!=10);
+}
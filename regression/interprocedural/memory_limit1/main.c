@@ -0,0 +1,27 @@
+int foo(int x)
+{
+  if(x>10)
+    return 10;
+  return x;
+}
+
+int bar(int x)
+{
+  if(x>3)
+    return x-3;
+  return 0;
+}
+
+int baz(int x)
+{
+  return foo(x)+bar(x);
+}
+
+void main()
+{
+  int x;
+  __CPROVER_assume(x>=0 && x<=5);
+  int y=baz(x);
+  assert(y<=20);
+  assert(foo(x)<=4);
+}
@@ -0,0 +1,19 @@
+int foo(int x)
+{
+  int r=x>5 ? 5 : x;
+  assert(r<=5);
+  return r;
+}
+
+int bar(int x)
+{
+  assert(x!=3);
+  return x;
+}
+
+void main()
+{
+  int x;
+  int y=foo(x);
+  int z=bar(y);
+}
@@ -0,0 +1,15 @@
+void main()
+{
+  int x=0, y=0, z=0;
+
+  while(x<10 && y<20)
+  {
+    ++x;
+    ++y;
+    z=x+y;
+  }
+
+  assert(x<=10);
+  assert(y<=20);
+  assert(z<=30);
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+
+void main()
+{
+  int x=0;
+  int y=0;
+  int z=0;
+
+  while(x<10)
+  {
+    ++x;
+    ++y;
+    if(z<5)
+      ++z;
+  }
+
+  assert(x==y);
+  assert(z<=5);
+}
@@ -0,0 +1,14 @@
+void main()
+{
+  unsigned n;
+  __CPROVER_assume(n<100);
+
+  unsigned i=0, j=0;
+  while(i<n)
+  {
+    ++i;
+    ++j;
+  }
+
+  assert(i==j);
+}
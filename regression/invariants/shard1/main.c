@@ -0,0 +1,13 @@
+void main()
+{
+  int x;
+  __CPROVER_assume(x>=0 && x<=10);
+  int y=x;
+  while(y<10)
+    y++;
+
+  assert(y!=10);
+  assert(y>=0);
+  assert(y==10);
+  assert(x<=y);
+}
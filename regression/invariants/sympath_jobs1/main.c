@@ -0,0 +1,16 @@
+void main()
+{
+  int x=0;
+  int y=0;
+  int n;
+  __CPROVER_assume(n>=0 && n<=10);
+
+  for(int i=0; i<n; i++)
+    x++;
+
+  for(int i=0; i<n; i++)
+    y++;
+
+  assert(x<=10);
+  assert(y<=10);
+}
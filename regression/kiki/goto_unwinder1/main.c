@@ -0,0 +1,12 @@
+#include <stdlib.h>
+
+void main()
+{
+  int *p=malloc(sizeof(int));
+  *p=0;
+
+  for(int i=0; i<3; i++)
+    ++*p;
+
+  assert(*p!=3);
+}
@@ -0,0 +1,20 @@
+int one(int n)
+{
+  if(n<=0)
+    return 1;
+  return one(n-1);
+}
+
+void main()
+{
+  int x=one(5);
+  int y=-x, z=x;
+
+  while(1)
+  {
+    z=y;
+    y=x;
+    x=-x;
+    assert(x==z);
+  }
+}
@@ -0,0 +1,24 @@
+int aaa(int x)
+{
+  if(x>0)
+    x--;
+  else
+    x++;
+  return x;
+}
+
+int foo()
+{
+  return 1;
+}
+int bar()
+{
+  return 2;
+}
+
+void main()
+{
+  int x = bar() + foo();
+  assert(x==3);
+  aaa(x);
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+#
+# Runs the given 2LS command line twice in the directory of a test, with the
+# summary cache in the directory 'cache' that is emptied first. The output of
+# the second run is checked by the test. If the test has a file warmup.c, it
+# is analyzed by the first run instead of the input file.
+
+args=("$@")
+if [ -f warmup.c ]
+then
+  args[${#args[@]}-1]=warmup.c
+fi
+
+rm -rf cache
+mkdir cache || exit 1
+"${args[@]}" > /dev/null 2>&1
+exec "$@"
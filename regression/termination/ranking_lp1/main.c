@@ -0,0 +1,17 @@
+void main()
+{
+  int x=10;
+  int y=10;
+
+  while(x>0)
+  {
+    if(y>0)
+      y--;
+    else
+    {
+      x--;
+      y=10;
+    }
+  }
+  assert(x==0);
+}
@@ -0,0 +1,12 @@
+void main()
+{
+  int x=0;
+  int y=100;
+
+  while(x<y)
+  {
+    x+=2;
+    y--;
+  }
+  assert(x>=y);
+}
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# Runs the regression suites with each of the given SAT solver backends
+# (see --sat-solver) and reports the run time and the result of each suite.
+# Usage: scripts/compare_sat_solvers.sh [solver...]
+# (default: default cadical)
+
+if ! [[ -e regression/test.pl ]]
+then
+  echo "Run the script from the root directory of 2LS"
+  exit 1
+fi
+
+solvers=("$@")
+if [[ ${#solvers[@]} -eq 0 ]]
+then
+  solvers=(default cadical)
+fi
+
+suites=`sed -n 's/^[ \t]*\([a-z-]*\)[ \t]*\\\\*$/\1/p' regression/Makefile`
+
+printf "%-20s" "suite"
+for solver in "${solvers[@]}"
+do
+  printf "%16s" "$solver"
+done
+printf "\n"
+
+for suite in $suites
+do
+  printf "%-20s" "$suite"
+  flags=`sed -n 's/^FLAGS = //p' regression/$suite/Makefile`
+  for solver in "${solvers[@]}"
+  do
+    start=`date +%s.%N`
+    if make -s -C regression/$suite test \
+         FLAGS="$flags --sat-solver $solver" > /dev/null 2>&1
+    then
+      result="ok"
+    else
+      result="FAIL"
+    fi
+    end=`date +%s.%N`
+    printf "%11.2fs %4s" `echo "$end - $start" | bc` "$result"
+  done
+  printf "\n"
+done
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+# Merges the results of 2LS runs with --shard i/N --results-json file into
+# one report. Each property is checked by exactly one shard; the merged
+# report contains the statuses of all properties, all counterexamples and
+# the invariants of all functions.
+# Usage: scripts/merge_shards.py [-o output.json] shard0.json shard1.json ...
+# The exit code follows 2LS: 0 (success), 10 (failure), 5 (unknown).
+
+import argparse
+import json
+import sys
+
+
+# the more decisive status wins if a property is reported by several files
+STATUS_RANK = {"FAILURE": 3, "SUCCESS": 2, "ERROR": 1}
+
+
+def status_rank(status):
+    return STATUS_RANK.get(status, 0)
+
+
+def merge(results):
+    shard_count = None
+    shards = set()
+    properties = {}
+    counterexamples = {}
+    invariants = {}
+
+    for file_name, result in results:
+        shard = result.get("shard", "0/1")
+        index, count = [int(n) for n in shard.split("/")]
+        if shard_count is None:
+            shard_count = count
+        elif shard_count != count:
+            sys.exit("%s: shard %s does not match %d shards"
+                     % (file_name, shard, shard_count))
+        shards.add(index)
+
+        for prop in result.get("properties", []):
+            name = prop["property"]
+            if name not in properties or \
+               status_rank(prop["status"]) > \
+               status_rank(properties[name]["status"]):
+                properties[name] = prop
+        counterexamples.update(result.get("counterexamples", {}))
+        for function, invariant in result.get("invariants", {}).items():
+            invariants.setdefault(function, invariant)
+
+    missing = sorted(set(range(shard_count or 0)) - shards)
+    statuses = [prop["status"] for prop in properties.values()]
+    if "FAILURE" in statuses:
+        verdict = "FAILURE"
+    elif missing or any(status != "SUCCESS" for status in statuses):
+        verdict = "UNKNOWN"
+    else:
+        verdict = "SUCCESS"
+
+    merged = {
+        "result": verdict,
+        "shards": shard_count,
+        "properties": [properties[name] for name in sorted(properties)],
+        "counterexamples": counterexamples,
+        "invariants": invariants,
+    }
+    if missing:
+        merged["missing_shards"] = missing
+    return merged
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Merge the --results-json files of 2LS shards")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    parser.add_argument("files", nargs="+", help="results of the shards")
+    args = parser.parse_args()
+
+    results = []
+    for file_name in args.files:
+        with open(file_name) as f:
+            results.append((file_name, json.load(f)))
+
+    merged = merge(results)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(merged, f, indent=2)
+            f.write("\n")
+    else:
+        json.dump(merged, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+
+    failed = sum(1 for prop in merged["properties"]
+                 if prop["status"] == "FAILURE")
+    unknown = sum(1 for prop in merged["properties"]
+                  if prop["status"] not in ("FAILURE", "SUCCESS"))
+    total = len(merged["properties"])
+    sys.stderr.write("** %d of %d unknown\n" % (unknown, total))
+    sys.stderr.write("** %d of %d failed\n" % (failed, total))
+    if merged.get("missing_shards"):
+        sys.stderr.write("missing shards: %s\n" %
+                         ", ".join(str(i) for i in merged["missing_shards"]))
+
+    return {"SUCCESS": 0, "FAILURE": 10}.get(merged["result"], 5)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
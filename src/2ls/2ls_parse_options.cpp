@@ -56,6 +56,8 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solver/summary_db.h>
 #include <ssa/dynobj_instance_analysis.h>
 #include <ssa/dynamic_objects.h>
+#include <domains/incremental_solver.h>
+#include <ssa/profiler.h>
 
 #include "2ls_parse_options.h"
 #include "summary_checker_ai.h"
@@ -239,6 +241,10 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
         options.set_option("enum-solver", true);
       else // if(cmdline.isset("binsearch-solver")) // default
         options.set_option("binsearch-solver", true);
+      if(cmdline.isset("binsearch-batch"))
+        options.set_option("binsearch-batch", true);
+      if(cmdline.isset("omt-solver"))
+        options.set_option("omt-solver", cmdline.get_value("omt-solver"));
     }
   }
 
@@ -293,6 +299,16 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("max-inner-ranking-iterations", 50);
 
+  if(cmdline.isset("ranking-engine"))
+  {
+    const std::string engine=cmdline.get_value("ranking-engine");
+    if(engine!="sat" && engine!="lp")
+      throw "--ranking-engine: expected sat or lp";
+    options.set_option("ranking-engine", engine);
+  }
+  else
+    options.set_option("ranking-engine", "sat");
+
   // do k-induction refinement
   if(cmdline.isset("k-induction"))
   {
@@ -349,6 +365,104 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("give-up-invariants", "2");
   }
 
+  // run several abstract domains in parallel processes
+  if(cmdline.isset("portfolio") && !options.get_bool_option("havoc"))
+  {
+    options.set_option("portfolio", true);
+    if(cmdline.isset("portfolio-domains"))
+      options.set_option(
+        "portfolio-domains", cmdline.get_value("portfolio-domains"));
+    else
+      options.set_option("portfolio-domains", "intervals,zones,octagons");
+    if(options.get_option("portfolio-domains").empty())
+      throw "--portfolio-domains requires a list of domains";
+    // these files would be written by all workers at once, other output
+    // files are redirected per worker (see run_portfolio)
+    if(cmdline.isset("summary-cache") ||
+       (cmdline.isset("json-cex") && cmdline.get_value("json-cex")!="-"))
+      throw "--portfolio cannot be used with --summary-cache or --json-cex";
+  }
+
+  // persistent summary cache
+  if(cmdline.isset("summary-cache"))
+    options.set_option("summary-cache", cmdline.get_value("summary-cache"));
+
+  // simplification of summaries joined from several calling contexts,
+  // optionally bounded in size
+  if(cmdline.isset("simplify-summaries") ||
+     cmdline.isset("summary-max-conjuncts"))
+    options.set_option("simplify-summaries", true);
+  if(cmdline.isset("summary-max-conjuncts"))
+    options.set_option(
+      "summary-max-conjuncts", cmdline.get_value("summary-max-conjuncts"));
+
+  // summarize functions and check properties in parallel processes
+  if(cmdline.isset("jobs"))
+    options.set_option("jobs", cmdline.get_value("jobs"));
+
+  // evict solvers of summarized functions above this resident memory (MB)
+  if(cmdline.isset("memory-limit"))
+    options.set_option("memory-limit", cmdline.get_value("memory-limit"));
+
+  // iterate the domains of a product domain in parallel processes
+  if(cmdline.isset("parallel-product"))
+    options.set_option("parallel-product", true);
+
+  // compute invariants for each symbolic path
+  if(cmdline.isset("sympath"))
+    options.set_option("sympath", true);
+
+  // compute invariants of symbolic paths in parallel processes
+  if(cmdline.isset("sympath-jobs"))
+    options.set_option("sympath-jobs", cmdline.get_value("sympath-jobs"));
+
+  // run times of the analysis phases
+  if(cmdline.isset("profile-json"))
+    options.set_option("profile-json", cmdline.get_value("profile-json"));
+
+  // seed strategy iteration with the invariants of the previous unwinding
+  if(cmdline.isset("reuse-invariants"))
+    options.set_option("reuse-invariants", true);
+
+  // summarize only the functions relevant to the checked properties
+  if(cmdline.isset("goal-driven"))
+    options.set_option("goal-driven", true);
+
+  // relational template rows only within packs of related variables
+  if(cmdline.isset("pack-size"))
+    options.set_option("pack-size", cmdline.get_value("pack-size"));
+
+  // check a part of the properties only
+  if(cmdline.isset("shard"))
+  {
+    const std::string shard=cmdline.get_value("shard");
+    std::size_t slash=shard.find('/');
+    if(slash==std::string::npos || slash==0 || slash+1==shard.size() ||
+       shard.find_first_not_of("0123456789/")!=std::string::npos ||
+       shard.find('/', slash+1)!=std::string::npos)
+      throw "--shard expects i/N";
+    const std::string index=shard.substr(0, slash);
+    const std::string count=shard.substr(slash+1);
+    if(safe_string2unsigned(count)==0 ||
+       safe_string2unsigned(index)>=safe_string2unsigned(count))
+      throw "--shard i/N requires 0<=i<N";
+    options.set_option("shard-index", index);
+    options.set_option("shard-count", count);
+  }
+
+  // verification results as JSON
+  if(cmdline.isset("results-json"))
+    options.set_option("results-json", cmdline.get_value("results-json"));
+
+  // SAT solver backend of the incremental solvers
+  if(cmdline.isset("sat-solver"))
+  {
+    options.set_option("sat-solver", cmdline.get_value("sat-solver"));
+    if(!incremental_solvert::is_sat_solver_available(
+         options.get_option("sat-solver")))
+      throw "--sat-solver: SAT solver not available in this build";
+  }
+
   // instrumentation / output
   if(cmdline.isset("instrument-output"))
     options.set_option(
@@ -391,6 +505,7 @@ int twols_parse_optionst::doit()
 
   optionst options;
   get_command_line_options(options);
+  profilert::get().enabled=options.is_set("profile-json");
 
   eval_verbosity();
 
@@ -522,6 +637,13 @@ int twols_parse_optionst::doit()
       goto_model.goto_functions.entry_point() << eom;
   }
 
+  if(options.get_bool_option("portfolio"))
+  {
+    int portfolio_retval;
+    if(run_portfolio(options, portfolio_retval))
+      return portfolio_retval;
+  }
+
   // TODO: check option inconsistencies, ignored options etc
   if(options.get_bool_option("havoc"))
     status() << "Havocking loops and function calls" << eom;
@@ -647,7 +769,8 @@ int twols_parse_optionst::doit()
       !options.get_bool_option("termination") &&
       !options.get_bool_option("nontermination");
     // do actual analysis
-    switch((*checker)())
+    resultt checker_result=(*checker)();
+    switch(checker_result)
     {
     case resultt::PASS:
       if(report_assertions)
@@ -730,6 +853,9 @@ int twols_parse_optionst::doit()
         ui_message_handler.get_verbosity());
     }
 
+    output_results_json(options, goto_model, *checker, checker_result);
+    output_profile(options);
+
     return retval;
   }
 
@@ -1390,6 +1516,92 @@ void twols_parse_optionst::output_graphml_cex(
   }
 }
 
+/// Writes the run times and counters collected by the profiler as JSON.
+void twols_parse_optionst::output_profile(const optionst &options)
+{
+  const std::string file=options.get_option("profile-json");
+  if(file.empty())
+    return;
+
+  json_objectt profile=profilert::get().to_json();
+  if(file=="-")
+    std::cout << profile << "\n";
+  else
+  {
+    std::ofstream out(file.c_str());
+    if(!out)
+    {
+      error() << "Failed to open profile file " << file << eom;
+      return;
+    }
+    out << profile << "\n";
+  }
+}
+
+/// Writes the verification result, the statuses of the properties, the
+/// counterexamples and the invariants as JSON. With --shard, the files of
+/// the shards can be merged by scripts/merge_shards.py.
+void twols_parse_optionst::output_results_json(
+  const optionst &options,
+  const goto_modelt &goto_model,
+  summary_checker_baset &summary_checker,
+  resultt result)
+{
+  const std::string file=options.get_option("results-json");
+  if(file.empty())
+    return;
+
+  const namespacet ns(goto_model.symbol_table);
+  json_objectt json_results;
+  if(options.is_set("shard-count"))
+  {
+    json_results["shard"]=json_stringt(
+      options.get_option("shard-index")+"/"+options.get_option("shard-count"));
+  }
+  json_results["result"]=json_stringt(
+    result==resultt::PASS ? "SUCCESS" :
+    result==resultt::FAIL ? "FAILURE" : "UNKNOWN");
+
+  json_arrayt &json_properties=json_results["properties"].make_array();
+  json_objectt json_counterexamples;
+  for(const auto &p : summary_checker.property_map)
+  {
+    // TODO: some properties do not show up in initialize_property_map
+    if(p.first=="")
+      continue;
+
+    json_objectt json_property;
+    json_property["property"]=json_stringt(p.first);
+    json_property["description"]=
+      json_stringt(p.second.pc->source_location().get_comment());
+    json_property["status"]=json_stringt(as_string(p.second.status));
+    json_properties.push_back(json_property);
+
+    if(p.second.status==property_statust::FAIL &&
+       summary_checker.traces.find(p.first)!=summary_checker.traces.end())
+    {
+      json_arrayt json_trace;
+      convert<json_arrayt>(ns, summary_checker.traces.at(p.first), json_trace);
+      json_counterexamples[id2string(p.first)]=json_trace;
+    }
+  }
+  json_results["counterexamples"]=json_counterexamples;
+  json_results["invariants"]=summary_checker.invariants_to_json();
+
+  if(file=="-")
+    std::cout << json_results << "\n";
+  else
+  {
+    std::ofstream out(file.c_str());
+    if(!out)
+    {
+      error() << "Failed to open results file " << file << eom;
+      return;
+    }
+    out << json_results << "\n";
+  }
+}
+
 void twols_parse_optionst::output_graphml_proof(
   const optionst &options,
   const goto_modelt &goto_model,
@@ -1543,8 +1755,14 @@ void twols_parse_optionst::help()
     " --stop-on-fail               stop on first failing assertion\n"
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
     " --context-sensitive          context-sensitive analysis from entry point\n" // NOLINT(*)
+    " --goal-driven                summarize only the functions that can influence the\n" // NOLINT(*)
+    "                              checked properties (e.g. given by --property)\n" // NOLINT(*)
     " --termination                compute ranking functions to prove termination\n" // NOLINT(*)
     " --k-induction                use k-induction\n"
+    " --reuse-invariants           in k-induction, start invariant inference from the\n" // NOLINT(*)
+    "                              invariants for the previous unwinding\n"
+    "                              (summaries are then not computed by --jobs or read\n" // NOLINT(*)
+    "                              from --summary-cache)\n"
     " --incremental-bmc            use incremental-bmc\n"
     " --preconditions              compute preconditions\n"
     " --sufficient                 sufficient preconditions (default: necessary)\n" // NOLINT(*)
@@ -1554,18 +1772,48 @@ void twols_parse_optionst::help()
     " --heap                       use heap domain\n"
     " --zones                      use zone domain\n"
     " --octagons                   use octagon domain\n"
+    " --pack-size n                relate only variables in packs of at most n related\n" // NOLINT(*)
+    "                              variables in zones and octagons\n"
     " --values-refine              use dynamic refinement of strength of the value domain\n" // NOLINT(*)
     " --sympath                    compute invariant for each symbolic path\n"
     "                              (only usable with --heap-* switches)\n"
     " --enum-solver                use solver based on model enumeration\n"
     " --binsearch-solver           use solver based on binary search\n"
+    " --binsearch-batch            improve all improvable template rows at once in binary search\n" // NOLINT(*)
+    " --omt-solver cmd             compute template row maxima by the OMT solver cmd (e.g. z3)\n" // NOLINT(*)
+    "                              instead of binary search\n"
     " --arrays                     use arrays domain\n"
     " --lexicographic-ranking-function n          (default n=3)\n"
     " --monolithic-ranking-function\n"
     " --max-inner-ranking-iterations n           (default n=20)\n"
+    " --ranking-engine e           search ranking function coefficients by SAT (sat, default)\n" // NOLINT(*)
+    "                              or by linear programming (lp)\n"
+    " --jobs n                     summarize independent functions and check properties\n" // NOLINT(*)
+    "                              in n parallel processes\n"
+    " --parallel-product           iterate the domains of combined domains\n"
+    "                              (e.g. --heap --intervals) in parallel processes\n" // NOLINT(*)
+    " --sympath-jobs n             with --sympath, compute invariants of symbolic paths\n" // NOLINT(*)
+    "                              in n parallel processes\n"
+    " --summary-cache dir          reuse function summaries stored in the existing directory dir\n" // NOLINT(*)
+    " --simplify-summaries         remove redundant conjuncts of summaries joined from\n" // NOLINT(*)
+    "                              several calling contexts\n"
+    " --summary-max-conjuncts n    simplify joined summaries and keep at most n conjuncts\n" // NOLINT(*)
+    "                              (default: no limit)\n"
+    " --portfolio                  run several domains in parallel processes, take the first conclusive result\n" // NOLINT(*)
+    " --portfolio-domains d1,...   domains for --portfolio (intervals, zones, octagons,\n" // NOLINT(*)
+    "                              equalities, heap; default: intervals,zones,octagons)\n" // NOLINT(*)
+    "                              (not with --summary-cache or --json-cex file)\n" // NOLINT(*)
+    " --sat-solver s               SAT solver for incremental solving (default, minisat2,\n" // NOLINT(*)
+    "                              glucose, cadical, ipasir; depends on the CBMC build)\n" // NOLINT(*)
+    " --memory-limit m             release the solvers of all summarized functions whenever\n" // NOLINT(*)
+    "                              the resident memory exceeds m MB, rebuild them on demand\n" // NOLINT(*)
+    " --shard i/N                  check only the i-th of N parts of the properties (0<=i<N)\n" // NOLINT(*)
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
+    " --profile-json file          write run times of analysis phases per function to file\n" // NOLINT(*)
+    " --results-json file          write property statuses, counterexamples and invariants\n" // NOLINT(*)
+    "                              to file (see scripts/merge_shards.py)\n"
     " --xml-ui                     use XML-formatted output\n"
     "\n";
 }
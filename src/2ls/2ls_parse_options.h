@@ -48,13 +48,13 @@ class optionst;
   "(heap)" \
   "(values-refine)" \
   "(sympath)" \
-  "(enum-solver)(binsearch-solver)(arrays)"\
+  "(enum-solver)(binsearch-solver)(binsearch-batch)(omt-solver):(arrays)"\
   "(string-abstraction)(no-arch)(arch):(floatbv)(fixedbv)" \
   "(round-to-nearest)(round-to-plus-inf)(round-to-minus-inf)(round-to-zero)" \
   "(inline)(inline-main)(inline-partial):(instrument-output):" \
   "(context-sensitive)(termination)(nontermination)" \
   "(lexicographic-ranking-function):(monolithic-ranking-function)" \
-  "(max-inner-ranking-iterations):" \
+  "(max-inner-ranking-iterations):(ranking-engine):" \
   "(preconditions)(sufficient)" \
   "(show-locs)(show-vcc)(show-properties)(trace)(show-stats)" \
   "(show-goto-functions)(show-guards)(show-defs)(show-ssa)(show-assignments)" \
@@ -66,7 +66,15 @@ class optionst;
   "(graphml-witness):(json-cex):" \
   "(no-spurious-check)(stop-on-fail)" \
   "(competition-mode)(slice)(no-propagation)(independent-properties)" \
-  "(no-unwinding-assertions)"
+  "(no-unwinding-assertions)" \
+  "(jobs):(parallel-product)(sympath-jobs):" \
+  "(portfolio)(portfolio-domains):" \
+  "(summary-cache):(summary-max-conjuncts):(simplify-summaries)" \
+  "(sat-solver):(memory-limit):" \
+  "(profile-json):" \
+  "(shard):(results-json):" \
+  "(reuse-invariants)(goal-driven)" \
+  "(pack-size):"
   // the last line is for CBMC-regression testing only
 // clang-format on
 
@@ -117,6 +125,14 @@ protected:
     const goto_modelt &,
     const summary_checker_baset &summary_checker);
 
+  void output_profile(const optionst &options);
+
+  void output_results_json(
+    const optionst &options,
+    const goto_modelt &goto_model,
+    summary_checker_baset &summary_checker,
+    resultt result);
+
   void output_graphml_proof(
     const optionst &options,
     const goto_modelt &goto_model,
@@ -162,6 +178,10 @@ protected:
 
   bool has_threads(const goto_modelt &goto_model);
 
+  // portfolio of abstract domains
+  bool run_portfolio(optionst &options, int &retval);
+  bool set_portfolio_domain(optionst &options, const std::string &domain);
+
   // diverse preprocessing
   void inline_main(goto_modelt &goto_model);
   void propagate_constants(goto_modelt &goto_model);
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/prop/literal_expr.h>
 
 #include <ssa/ssa_build_goto_trace.h>
+#include <ssa/profiler.h>
 
 #include "cover_goals_ext.h"
 
@@ -65,6 +66,8 @@ void cover_goals_extt::freeze_goal_variables()
 /// Try to cover all goals
 void cover_goals_extt::operator()()
 {
+  profilert::scoped_timert timer("property_checking", SSA.function_identifier);
+
   _iterations=_number_covered=0;
 
   decision_proceduret::resultt dec_result;
@@ -138,6 +141,8 @@ void cover_goals_extt::assignment()
         property_map.at(it->first).status=property_statust::FAIL;
         if(build_error_trace)
         {
+          profilert::scoped_timert timer(
+            "trace_building", SSA.function_identifier);
           ssa_build_goto_tracet build_goto_trace(SSA, solver.get_solver());
           build_goto_trace(traces[it->first]);
           if(!all_properties)
@@ -168,6 +173,8 @@ void cover_goals_extt::assignment()
         property_map.at(it->first).status=property_statust::FAIL;
         if(build_error_trace)
         {
+          profilert::scoped_timert timer(
+            "trace_building", SSA.function_identifier);
           ssa_build_goto_tracet build_goto_trace(SSA, solver.get_solver());
           build_goto_trace(traces[it->first]);
 
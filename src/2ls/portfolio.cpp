@@ -0,0 +1,217 @@
+/*******************************************************************\
+
+Module: 2LS Portfolio of Abstract Domains
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// 2LS Portfolio of Abstract Domains
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <set>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+
+#include <util/options.h>
+#include <util/string_utils.h>
+#include <util/tempfile.h>
+
+#include "2ls_parse_options.h"
+
+/// Configures the options to use the given abstract domain instead of the
+/// value domain. The other domains given by the user (e.g. --arrays) are
+/// kept.
+/// \return false if the domain is not supported
+bool twols_parse_optionst::set_portfolio_domain(
+  optionst &options,
+  const std::string &domain)
+{
+  options.set_option("values-refine", false);
+  options.set_option("intervals", false);
+  options.set_option("zones", false);
+  options.set_option("qzones", false);
+  options.set_option("octagons", false);
+
+  if(domain=="intervals" || domain=="zones" || domain=="octagons")
+  {
+    options.set_option(domain, true);
+    if(!options.get_bool_option("enum-solver"))
+      options.set_option("binsearch-solver", true);
+  }
+  else if(domain=="equalities")
+  {
+    options.set_option("equalities", true);
+    options.set_option("std-invariants", true);
+  }
+  else if(domain=="heap" && options.get_bool_option("inline"))
+    options.set_option("heap", true);
+  else
+    return false;
+
+  // in the order of get_command_line_options
+  const char *domain_names[]=
+    { "equalities", "heap", "arrays", "zones", "octagons", "intervals" };
+  optionst::value_listt simple_domains;
+  for(const auto &domain_name : domain_names)
+  {
+    if(options.get_bool_option(domain_name))
+      simple_domains.push_back(domain_name);
+  }
+  options.set_option("simple-domains", simple_domains);
+  return true;
+}
+
+/// Runs the analysis with several abstract domains in parallel worker
+/// processes and takes the verdict of the first one that is conclusive.
+/// The remaining workers are killed.
+/// \param options: options of the analysis, modified in worker processes to
+///   use the domain of the worker
+/// \param retval: exit code of the winning worker (set in the parent process)
+/// \return true in the parent process, false in a worker process which
+///   should continue with the analysis
+bool twols_parse_optionst::run_portfolio(optionst &options, int &retval)
+{
+  std::vector<std::string> domains;
+  split_string(
+    options.get_option("portfolio-domains"), ',', domains, true, true);
+
+#ifdef _WIN32
+  warning() << "Portfolio mode not supported on this platform, using "
+            << domains.front() << " domain" << eom;
+  set_portfolio_domain(options, domains.front());
+  return false;
+#else
+  struct workert
+  {
+    std::string domain;
+    std::string output_file;
+    // output file option -> file written by the worker
+    std::map<std::string, std::string> files;
+  };
+  std::map<pid_t, workert> workers;
+  std::vector<pid_t> worker_order;
+
+  // Each worker writes the output files to its own files, those of the
+  // winning worker are then renamed. Killed workers may leave incomplete
+  // files, which are removed.
+  const char *file_options[]=
+    { "graphml-witness", "results-json", "profile-json" };
+
+  for(const auto &domain : domains)
+  {
+    workert worker;
+    worker.domain=domain;
+    worker.output_file=get_temporary_file("2ls_portfolio_", ".out");
+    for(const auto &file_option : file_options)
+    {
+      const std::string file=options.get_option(file_option);
+      if(!file.empty() && file!="-")
+        worker.files[file_option]=file+"."+domain;
+    }
+
+    std::cout.flush();
+    pid_t pid=fork();
+    if(pid==0)
+    {
+      // own process group so that helper processes are killed as well
+      setpgid(0, 0);
+      if(!set_portfolio_domain(options, domain))
+      {
+        error() << "Unsupported portfolio domain " << domain << eom;
+        _exit(6);
+      }
+      for(const auto &file : worker.files)
+        options.set_option(file.first, file.second);
+
+      // the output is shown by the parent for the winning worker only
+      if(!freopen(worker.output_file.c_str(), "w", stdout))
+        _exit(6);
+      return false;
+    }
+    else if(pid<0)
+    {
+      error() << "Cannot start portfolio worker for " << domain << eom;
+      std::remove(worker.output_file.c_str());
+      continue;
+    }
+
+    setpgid(pid, pid);
+    status() << "Portfolio: running " << domain << " domain" << eom;
+    workers[pid]=worker;
+    worker_order.push_back(pid);
+  }
+
+  if(workers.empty())
+    throw "no portfolio worker could be started";
+
+  // output of the first configuration is shown if no worker is conclusive
+  pid_t winner=worker_order.front();
+  retval=5;
+  std::set<pid_t> finished;
+  while(finished.size()<workers.size())
+  {
+    int worker_status;
+    pid_t pid=wait(&worker_status);
+    if(pid<0)
+      break;
+    if(workers.find(pid)==workers.end())
+      continue;
+    finished.insert(pid);
+
+    int exit_code=
+      WIFEXITED(worker_status) ? WEXITSTATUS(worker_status) : 6;
+    status() << "Portfolio: " << workers[pid].domain << " domain finished"
+             << " with exit code " << exit_code << eom;
+
+    // verification successful or failed
+    if(exit_code==0 || exit_code==10)
+    {
+      winner=pid;
+      retval=exit_code;
+
+      for(const auto &worker : workers)
+      {
+        if(finished.find(worker.first)!=finished.end())
+          continue;
+        kill(-worker.first, SIGKILL);
+        waitpid(worker.first, nullptr, 0);
+      }
+      break;
+    }
+    else if(pid==winner)
+      retval=exit_code;
+  }
+
+  for(const auto &worker : workers)
+  {
+    if(worker.first==winner)
+    {
+      std::ifstream in(worker.second.output_file.c_str());
+      std::cout << in.rdbuf();
+      std::cout.flush();
+      for(const auto &file : worker.second.files)
+      {
+        std::rename(
+          file.second.c_str(), options.get_option(file.first).c_str());
+      }
+    }
+    else
+    {
+      for(const auto &file : worker.second.files)
+        std::remove(file.second.c_str());
+    }
+    std::remove(worker.second.output_file.c_str());
+  }
+
+  return true;
+#endif
+}
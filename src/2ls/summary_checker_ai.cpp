@@ -32,6 +32,7 @@ resultt summary_checker_ait::operator()()
   // properties
   property_map=initialize_properties(goto_model);
   set_properties_unknown();
+  restrict_properties_to_shard();
 
   resultt result=resultt::UNKNOWN;
   bool finished=false;
@@ -10,8 +10,22 @@ Author: Peter Schrammel
 /// Summary Checker Base
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
 
 #include <util/options.h>
+#include <util/tempfile.h>
+#include <util/irep_serialization.h>
 #include <util/simplify_expr.h>
 #include <langapi/language_util.h>
 #include <util/prefix.h>
@@ -25,7 +39,9 @@ Author: Peter Schrammel
 #include <ssa/local_ssa.h>
 #include <ssa/simplify_ssa.h>
 #include <ssa/ssa_build_goto_trace.h>
+#include <ssa/profiler.h>
 #include <domains/ssa_analyzer.h>
+#include <domains/solver_pool.h>
 
 #include <solver/summarizer_fw.h>
 #include <solver/summarizer_fw_term.h>
@@ -70,6 +86,63 @@ void summary_checker_baset::SSA_functions(
   // properties
   property_map=initialize_properties(goto_model);
   set_properties_unknown();
+  restrict_properties_to_shard();
+}
+
+/// With --shard i/N, only the properties whose identifier is mapped to
+/// shard i by a hash function are kept in the property map, so that the
+/// properties of a program can be checked by N independent processes.
+void summary_checker_baset::restrict_properties_to_shard()
+{
+  unsigned shard_count=options.get_unsigned_int_option("shard-count");
+  if(shard_count<=1)
+    return;
+  unsigned shard_index=options.get_unsigned_int_option("shard-index");
+
+  for(propertiest::iterator p_it=property_map.begin();
+      p_it!=property_map.end();)
+  {
+    // FNV-1a, the partition must not depend on the platform or build
+    std::uint32_t hash=2166136261u;
+    for(const char c : id2string(p_it->first))
+    {
+      hash^=static_cast<unsigned char>(c);
+      hash*=16777619u;
+    }
+
+    if(hash%shard_count==shard_index)
+      ++p_it;
+    else
+      p_it=property_map.erase(p_it);
+  }
+
+  status() << "Shard " << shard_index << "/" << shard_count << ": checking "
+           << property_map.size() << " properties" << eom;
+}
+
+/// \return true if the function contains an assertion whose property is
+///   to be checked
+bool summary_checker_baset::has_properties(
+  const ssa_dbt::functionst::const_iterator f_it) const
+{
+  const goto_programt &goto_program=f_it->second->goto_function.body;
+  for(const auto &instruction : goto_program.instructions)
+  {
+    if(instruction.is_assert() &&
+       property_map.find(instruction.source_location().get_property_id())!=
+       property_map.end())
+      return true;
+  }
+  return false;
+}
+
+/// Counterexample traces are built only if they are output.
+bool summary_checker_baset::traces_needed() const
+{
+  return options.get_bool_option("trace") ||
+         options.get_option("graphml-witness")!="" ||
+         options.get_option("json-cex")!="" ||
+         options.get_option("results-json")!="";
 }
 
 void summary_checker_baset::summarize(
@@ -103,8 +176,24 @@ void summary_checker_baset::summarize(
 
   summarizer->set_message_handler(get_message_handler());
 
-  if(!options.get_bool_option("context-sensitive") &&
-     options.get_bool_option("all-functions"))
+  // with --goal-driven and in a shard, only the functions relevant to the
+  // checked properties are summarized
+  if(forward && !termination &&
+     (options.get_bool_option("goal-driven") ||
+      options.get_unsigned_int_option("shard-count")>1))
+  {
+    std::set<irep_idt> goals;
+    for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
+        f_it!=ssa_db.functions().end(); f_it++)
+    {
+      if(has_properties(f_it))
+        goals.insert(f_it->first);
+    }
+    summarizer->summarize_goals(
+      goto_model.goto_functions.entry_point(), goals);
+  }
+  else if(!options.get_bool_option("context-sensitive") &&
+          options.get_bool_option("all-functions"))
     summarizer->summarize();
   else
     summarizer->summarize(goto_model.goto_functions.entry_point());
@@ -118,27 +207,115 @@ void summary_checker_baset::summarize(
   delete summarizer;
 }
 
-resultt summary_checker_baset::check_properties()
+/// Marks for recomputation the summaries of the functions whose SSA is
+/// changed by unwinding and of their transitive callers, which use the
+/// summaries of the callees. The summaries of the other functions remain
+/// valid for all unwindings. With calling contexts, a change of a caller
+/// also changes the summaries of its callees, hence all summaries are
+/// recomputed.
+void summary_checker_baset::mark_recompute_unwound()
 {
-  // analyze all the functions
-  for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
-      f_it!=ssa_db.functions().end(); f_it++)
+  if(options.get_bool_option("context-sensitive"))
   {
-    status() << "Checking properties of " << f_it->first << messaget::eom;
+    summary_db.mark_recompute_all();
+    return;
+  }
 
-#if 0
-    // for debugging
-    show_ssa_symbols(*f_it->second, std::cerr);
-#endif
+  std::map<irep_idt, std::set<irep_idt>> callers;
+  std::vector<irep_idt> worklist;
+  for(const auto &f : ssa_db.functions())
+  {
+    if(ssa_unwinder->get(f.first).is_unwinding_dependent())
+      worklist.push_back(f.first);
 
-    check_properties(f_it);
+    for(const auto &node : f.second->nodes)
+    {
+      for(const auto &call : node.function_calls)
+      {
+        if(call.function().id()==ID_symbol)
+        {
+          irep_idt callee=to_symbol_expr(call.function()).get_identifier();
+          callers[callee].insert(f.first);
+        }
+      }
+    }
+  }
+
+  std::set<irep_idt> recompute;
+  while(!worklist.empty())
+  {
+    irep_idt f=worklist.back();
+    worklist.pop_back();
+    if(!recompute.insert(f).second)
+      continue;
+    worklist.insert(worklist.end(), callers[f].begin(), callers[f].end());
+  }
+
+  unsigned summaries=0, recomputed=0;
+  for(const auto &f : ssa_db.functions())
+  {
+    if(!summary_db.exists(f.first))
+      continue;
+    summaries++;
+    if(recompute.count(f.first))
+    {
+      summary_db.mark_recompute(f.first);
+      recomputed++;
+    }
+  }
+
+  status() << recomputed << " of " << summaries
+           << " summaries depend on the unwinding" << eom;
+}
+
+resultt summary_checker_baset::check_properties()
+{
+  if(check_properties_in_workers_enabled())
+  {
+    check_properties_in_workers();
 
     if(options.get_bool_option("show-invariants"))
     {
-      if(!summary_db.exists(f_it->first))
+      for(const auto &f : ssa_db.functions())
+      {
+        if(!summary_db.exists(f.first))
+          continue;
+        show_invariants(*f.second, summary_db.get(f.first), result());
+        result() << eom;
+      }
+    }
+  }
+  else
+  {
+    // analyze all the functions
+    for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
+        f_it!=ssa_db.functions().end(); f_it++)
+    {
+      // the properties of other shards are checked elsewhere, functions
+      // without properties are not summarized in goal-driven mode
+      if((options.get_unsigned_int_option("shard-count")>1 ||
+          options.get_bool_option("goal-driven")) &&
+         !has_properties(f_it))
         continue;
-      show_invariants(*(f_it->second), summary_db.get(f_it->first), result());
-      result() << eom;
+
+      status() << "Checking properties of " << f_it->first << messaget::eom;
+
+#if 0
+      // for debugging
+      show_ssa_symbols(*f_it->second, std::cerr);
+#endif
+
+      check_properties(f_it);
+      ssa_db.enforce_memory_limit(summary_db);
+
+      if(options.get_bool_option("show-invariants"))
+      {
+        if(!summary_db.exists(f_it->first))
+          continue;
+        show_invariants(
+          *(f_it->second), summary_db.get(f_it->first), result());
+        result() << eom;
+      }
     }
   }
 
@@ -211,9 +388,7 @@ void summary_checker_baset::check_properties(
     SSA, solver, loophead_selects, property_map, traces,
     !fully_unwound && options.get_bool_option("spurious-check"),
     all_properties,
-    options.get_bool_option("trace") ||
-    options.get_option("graphml-witness")!="" ||
-    options.get_option("json-cex")!="");
+    traces_needed());
 
 #if 0
   debug() << "(C) " << from_expr(SSA.ns, "", enabling_expr) << eom;
@@ -232,6 +407,10 @@ void summary_checker_baset::check_properties(
     const source_locationt &location=i_it->source_location();
     irep_idt property_id=location.get_property_id();
 
+    // the property is checked by another shard
+    if(property_map.find(property_id)==property_map.end())
+      continue;
+
     if(i_it->condition().is_true())
     {
       property_map.at(property_id).status=property_statust::PASS;
@@ -314,20 +493,257 @@ void summary_checker_baset::check_properties(
           << cover_goals.iterations() << " iterations)" << eom;
 }
 
+/// Parallel property checking is used only when requested by --jobs.
+bool summary_checker_baset::check_properties_in_workers_enabled() const
+{
+#ifdef _WIN32
+  return false;
+#else
+  return options.get_unsigned_int_option("jobs")>1 &&
+         ssa_db.functions().size()>1;
+#endif
+}
+
+/// Checks the properties of the functions in parallel worker processes, one
+/// process per function and at most --jobs processes at a time. Each worker
+/// is forked from the current state, so it has all the summaries and its own
+/// copy of the solver of the function. The statuses of the properties are
+/// sent back through a temporary file. Counterexample traces cannot be
+/// transferred, hence if traces are requested, the functions with failing
+/// properties are checked again in this process. Unless all properties are
+/// to be checked, the remaining workers are killed after the first failing
+/// property is found.
+void summary_checker_baset::check_properties_in_workers()
+{
+#ifdef _WIN32
+  for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
+      f_it!=ssa_db.functions().end(); f_it++)
+  {
+    status() << "Checking properties of " << f_it->first << messaget::eom;
+    check_properties(f_it);
+  }
+#else
+  std::size_t jobs=options.get_unsigned_int_option("jobs");
+  bool all_properties=options.get_bool_option("all-properties");
+  bool need_traces=traces_needed();
+
+  status() << "Checking properties of " << ssa_db.functions().size()
+           << " functions in " << jobs << " worker processes" << eom;
+
+  struct workert
+  {
+    ssa_dbt::functionst::const_iterator f_it;
+    std::string file_name;
+  };
+  std::map<pid_t, workert> workers;
+  std::vector<ssa_dbt::functionst::const_iterator> recheck;
+  bool failed=false;
+  bool stop=false;
+
+  ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
+  while(!workers.empty() || (!stop && f_it!=ssa_db.functions().end()))
+  {
+    while(!stop &&
+          f_it!=ssa_db.functions().end() &&
+          workers.size()<jobs)
+    {
+      if((options.get_unsigned_int_option("shard-count")>1 ||
+          options.get_bool_option("goal-driven")) &&
+         !has_properties(f_it))
+      {
+        f_it++;
+        continue;
+      }
+
+      workert worker;
+      worker.f_it=f_it++;
+      worker.file_name=get_temporary_file("2ls_properties_", ".bin");
+
+      std::cout.flush();
+      pid_t pid=fork();
+      if(pid==0)
+      {
+        int exit_code=0;
+        try
+        {
+          status() << "Checking properties of " << worker.f_it->first << eom;
+
+          std::map<irep_idt, property_statust> status_before;
+          for(const auto &property : property_map)
+            status_before[property.first]=property.second.status;
+          incremental_solvert &solver=ssa_db.get_solver(worker.f_it->first);
+          unsigned solver_calls_before=
+            solver_calls+solver.get_number_of_solver_calls();
+
+          check_properties(worker.f_it);
+
+          irept result("properties");
+          for(const auto &property : property_map)
+          {
+            if(property.second.status==status_before[property.first])
+              continue;
+            irept entry("entry");
+            entry.set(ID_name, property.first);
+            entry.set("status", static_cast<int>(property.second.status));
+            result.get_sub().push_back(entry);
+          }
+          result.set(
+            "solver_calls",
+            solver_calls+solver.get_number_of_solver_calls()-
+            solver_calls_before);
+
+          std::ofstream out(worker.file_name, std::ios::binary);
+          irep_serializationt::ireps_containert ireps_container;
+          irep_serializationt irep_serialization(ireps_container);
+          irep_serialization.reference_convert(result, out);
+          out.close();
+          if(!out)
+            exit_code=1;
+        }
+        catch(...)
+        {
+          exit_code=1;
+        }
+        std::cout.flush();
+        _exit(exit_code);
+      }
+      else if(pid<0)
+      {
+        // could not fork, check in this process
+        std::remove(worker.file_name.c_str());
+        status() << "Checking properties of " << worker.f_it->first << eom;
+        check_properties(worker.f_it);
+        if(!all_properties)
+        {
+          for(const auto &property : property_map)
+            if(property.second.status==property_statust::FAIL)
+              stop=true;
+        }
+      }
+      else
+        workers[pid]=worker;
+    }
+
+    if(workers.empty())
+      continue;
+
+    int worker_status;
+    pid_t pid=wait(&worker_status);
+    if(pid<0)
+    {
+      failed=true;
+      break;
+    }
+    std::map<pid_t, workert>::iterator w_it=workers.find(pid);
+    if(w_it==workers.end())
+      continue;
+    workert worker=w_it->second;
+    workers.erase(w_it);
+
+    if(!WIFEXITED(worker_status) || WEXITSTATUS(worker_status)!=0)
+    {
+      // workers killed after a failing property are not an error
+      if(!stop)
+        failed=true;
+      std::remove(worker.file_name.c_str());
+      continue;
+    }
+
+    std::ifstream in(worker.file_name, std::ios::binary);
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    irept result=irep_serialization.reference_convert(in);
+    in.close();
+    std::remove(worker.file_name.c_str());
+
+    bool function_failed=false;
+    for(const auto &entry : result.get_sub())
+    {
+      if(static_cast<property_statust>(entry.get_int("status"))==
+         property_statust::FAIL)
+        function_failed=true;
+    }
+
+    if(function_failed && need_traces)
+      recheck.push_back(worker.f_it);
+    else
+    {
+      for(const auto &entry : result.get_sub())
+      {
+        property_map.at(entry.get(ID_name)).status=
+          static_cast<property_statust>(entry.get_int("status"));
+      }
+    }
+    solver_calls+=result.get_long_long("solver_calls");
+
+    if(function_failed && !all_properties && !stop)
+    {
+      stop=true;
+      for(const auto &w : workers)
+        kill(w.first, SIGKILL);
+    }
+  }
+
+  for(const auto &worker : workers)
+  {
+    kill(worker.first, SIGKILL);
+    waitpid(worker.first, nullptr, 0);
+    std::remove(worker.second.file_name.c_str());
+  }
+
+  if(failed)
+    throw "property checking worker process failed";
+
+  // obtain the counterexample traces
+  for(const auto &f_it : recheck)
+  {
+    status() << "Checking properties of " << f_it->first << eom;
+    check_properties(f_it);
+    if(!all_properties)
+      break;
+  }
+#endif
+}
+
+/// \return the invariants of the functions as text, by function name
+json_objectt summary_checker_baset::invariants_to_json()
+{
+  json_objectt invariants;
+  for(const auto &f : ssa_db.functions())
+  {
+    if(!summary_db.exists(f.first))
+      continue;
+    std::ostringstream out;
+    show_invariants(*f.second, summary_db.get(f.first), out);
+    invariants[id2string(f.first)]=json_stringt(out.str());
+  }
+  return invariants;
+}
+
 void summary_checker_baset::report_statistics()
 {
   for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
       f_it!=ssa_db.functions().end(); f_it++)
   {
-    incremental_solvert &solver=ssa_db.get_solver(f_it->first);
-    unsigned calls=solver.get_number_of_solver_calls();
+    unsigned calls=ssa_db.get_number_of_solver_calls(f_it->first);
     if(calls>0)
       solver_instances++;
     solver_calls+=calls;
+    profilert::get().set_count("solver_calls", f_it->first, calls);
   }
   statistics() << "** statistics: " << eom;
   statistics() << "  number of solver instances: " << solver_instances << eom;
   statistics() << "  number of solver calls: " << solver_calls << eom;
+  statistics() << "  solver pool: "
+               << solver_poolt::get().allocations << " allocated, "
+               << solver_poolt::get().reuses << " reused, "
+               << solver_poolt::get().discards << " discarded" << eom;
+  if(options.get_unsigned_int_option("memory-limit")>0)
+  {
+    statistics() << "  memory limit: " << ssa_db.evictions
+                 << " solvers evicted, " << ssa_db.rebuilds << " rebuilt"
+                 << eom;
+  }
   statistics() << "  number of summaries used: "
                << summaries_used << eom;
   statistics() << "  number of termination arguments computed: "
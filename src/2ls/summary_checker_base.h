@@ -17,6 +17,7 @@ Author: Peter Schrammel
 #include <goto-checker/goto_trace_storage.h>
 #include <util/ui_message.h>
 #include <util/make_unique.h>
+#include <util/json.h>
 
 #include <ssa/local_ssa.h>
 #include <ssa/unwinder.h>
@@ -55,6 +56,14 @@ public:
     summaries_used(0),
     termargs_computed(0)
   {
+    if(options.get_option("summary-cache")!="")
+      summary_db.set_cache_directory(options.get_option("summary-cache"));
+    if(options.get_bool_option("simplify-summaries"))
+    {
+      summary_db.set_join_simplification(
+        goto_model.symbol_table,
+        options.get_unsigned_int_option("summary-max-conjuncts"));
+    }
     if(options.get_bool_option("unwind-goto"))
       ssa_unwinder=util_make_unique<goto_unwindert>(
         ssa_db,
@@ -78,12 +87,15 @@ public:
     messaget::set_message_handler(_message_handler);
     ssa_inliner.set_message_handler(_message_handler);
     ssa_db.set_message_handler(_message_handler);
+    summary_db.set_message_handler(_message_handler);
   }
 
   propertiest property_map;
 
   tracest traces;
 
+  json_objectt invariants_to_json();
+
 protected:
   optionst &options;
 
@@ -113,10 +125,16 @@ protected:
     const goto_modelt &,
     bool forward=true,
     bool termination=false);
+  void mark_recompute_unwound();
 
   resultt check_properties();
   virtual void check_properties(
     const ssa_dbt::functionst::const_iterator f_it);
+  virtual bool check_properties_in_workers_enabled() const;
+  void check_properties_in_workers();
+  void restrict_properties_to_shard();
+  bool has_properties(const ssa_dbt::functionst::const_iterator f_it) const;
+  bool traces_needed() const;
 
   exprt::operandst get_loophead_selects(
     const irep_idt &function_name,
@@ -30,10 +30,8 @@ resultt summary_checker_kindt::operator()()
   {
     status() << "Unwinding (k=" << unwind << ")" << eom;
 
-    // TODO: recompute only functions with loops
-    summary_db.mark_recompute_all();
-
     ssa_unwinder->unwind_all(unwind);
+    mark_recompute_unwound();
 
     result=check_properties();
     bool magic_limit_not_reached=
@@ -109,9 +109,7 @@ void summary_checker_nontermt::check_properties(
     traces,
     false,
     false,
-    options.get_bool_option("trace") ||
-    options.get_option("graphml-witness")!="" ||
-    options.get_option("json-cex")!="");
+    traces_needed());
 
   property_map.clear();
 
@@ -35,6 +35,9 @@ public:
 
 protected:
   resultt check_nonterm_linear();
+
+  // check_properties replaces the property map
+  bool check_properties_in_workers_enabled() const override { return false; }
 };
 
 #endif // CPROVER_2LS_2LS_SUMMARY_CHECKER_NONTERM_H
@@ -112,6 +112,11 @@ public:
     /// taking ownership of the created object.
     virtual valuet *clone()=0;
 
+    /// Conversion from/to irep for passing values between processes.
+    /// Values that cannot be converted return a nil irep.
+    virtual irept to_irep() const { return get_nil_irep(); }
+    virtual void from_irep(const irept &irep) {}
+
     basic_valuet basic_value;
   };
 
@@ -186,6 +191,13 @@ public:
     return nullptr;
   }
 
+  /// Tells whether a value of the given domain can be used as the initial
+  /// value of strategy iteration in this domain. This is the case if both
+  /// have the same template (e.g. for different unwindings of the same
+  /// function) and the strategy solver only weakens the value until it is
+  /// inductive, so that the result is sound for any initial value.
+  virtual bool can_seed_from(const domaint &other) const { return false; }
+
 protected:
   unsigned domain_number; // serves as id for variables names
   replace_mapt &renaming_map;
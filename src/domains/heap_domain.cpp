@@ -281,6 +281,48 @@ const exprt heap_domaint::get_points_to_dest(
     return nil_exprt();
 }
 
+irept heap_domaint::heap_valuet::to_irep() const
+{
+  irept irep("heap_value");
+  irep.set("basic_value", static_cast<long long>(basic_value));
+  for(const auto &row : *this)
+  {
+    irept row_irep("row");
+    row_irep.set("nondet", static_cast<long long>(row.nondet));
+    for(const auto &points_to : row.may_point_to)
+    {
+      irept points_to_irep("points_to");
+      for(const auto &destination : points_to)
+        points_to_irep.get_sub().push_back(destination);
+      row_irep.get_sub().push_back(points_to_irep);
+    }
+    irep.get_sub().push_back(row_irep);
+  }
+  return irep;
+}
+
+/// Rows must have been initialized (they refer to the namespace and the
+/// dynamic objects), only their points-to relations are replaced.
+void heap_domaint::heap_valuet::from_irep(const irept &irep)
+{
+  basic_value=static_cast<basic_valuet>(irep.get_long_long("basic_value"));
+  const irept::subt &rows=irep.get_sub();
+  assert(rows.size()==size());
+  for(std::size_t i=0; i<rows.size(); ++i)
+  {
+    row_valuet &row=(*this)[i];
+    row.nondet=rows[i].get_long_long("nondet")!=0;
+    row.may_point_to.clear();
+    for(const auto &points_to_irep : rows[i].get_sub())
+    {
+      row_valuet::points_to_relt points_to;
+      for(const auto &destination : points_to_irep.get_sub())
+        points_to.push_back(static_cast<const exprt &>(destination));
+      row.may_point_to.insert(points_to);
+    }
+  }
+}
+
 void heap_domaint::template_row_exprt::output(
   std::ostream &out,
   const namespacet &ns) const
@@ -91,6 +91,9 @@ public:
     }
 
     heap_valuet *clone() override { return new heap_valuet(*this); }
+
+    irept to_irep() const override;
+    void from_irep(const irept &irep) override;
   };
 
   std::unique_ptr<domaint::valuet> new_value() override
@@ -101,9 +104,19 @@ public:
   // Initialize value and domain
   void initialize_value(domaint::valuet &value) override;
 
+  bool can_seed_from(const domaint &other) const override
+  {
+    auto other_domain=dynamic_cast<const heap_domaint *>(&other);
+    return other_domain!=nullptr && same_template(*other_domain);
+  }
+
   // Handle row edit - join the model obtained from SMT with inv
   bool edit_row(const rowt &row, valuet &inv, bool improved) override;
 
+  // All points-to destinations of the improvable rows are collected in one
+  // strategy solver iteration
+  bool enumerate_models() const override { return true; }
+
   // Conversion of solver value to expression
   static exprt value_to_ptr_exprt(const exprt &expr);
 
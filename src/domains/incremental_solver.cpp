@@ -16,11 +16,65 @@ Author: Peter Schrammel
 #include <set>
 
 #include <solvers/flattening/bv_pointers.h>
+#ifdef HAVE_MINISAT2
+#include <solvers/sat/satcheck_minisat2.h>
+#endif
+#ifdef HAVE_GLUCOSE
+#include <solvers/sat/satcheck_glucose.h>
+#endif
+#ifdef HAVE_CADICAL
+#include <solvers/sat/satcheck_cadical.h>
+#endif
+#ifdef HAVE_IPASIR
+#include <solvers/sat/satcheck_ipasir.h>
+#endif
 
 #include "incremental_solver.h"
 
+/// Creates a SAT solver of the given backend. The available backends depend
+/// on the SAT solvers CBMC has been built with.
+/// \param sat_solver: name of the backend (minisat2, glucose, cadical,
+///   ipasir), empty or "default" for the default solver of CBMC
+/// \return NULL if the backend is not available
+propt *incremental_solvert::allocate_sat_check(
+  const std::string &sat_solver,
+  message_handlert &message_handler)
+{
+  if(sat_solver.empty() || sat_solver=="default")
+    return new satcheckt(message_handler);
+#ifdef HAVE_MINISAT2
+  if(sat_solver=="minisat2")
+    return new satcheck_minisat_simplifiert(message_handler);
+#endif
+#ifdef HAVE_GLUCOSE
+  if(sat_solver=="glucose")
+    return new satcheck_glucose_simplifiert(message_handler);
+#endif
+#ifdef HAVE_CADICAL
+  if(sat_solver=="cadical")
+    return new satcheck_cadicalt(message_handler);
+#endif
+#ifdef HAVE_IPASIR
+  if(sat_solver=="ipasir")
+    return new satcheck_ipasirt(message_handler);
+#endif
+  return NULL;
+}
+
+bool incremental_solvert::is_sat_solver_available(
+  const std::string &sat_solver)
+{
+  null_message_handlert message_handler;
+  propt *sat_check=allocate_sat_check(sat_solver, message_handler);
+  if(sat_check==NULL)
+    return false;
+  delete sat_check;
+  return true;
+}
+
 void incremental_solvert::new_context()
 {
+  context_depth++;
 #ifdef NON_INCREMENTAL
   contexts.push_back(constraintst());
 
@@ -30,6 +84,8 @@ void incremental_solvert::new_context()
 
 #else
   solver->push();
+  if(record_constraints)
+    contexts.push_back(constraintst());
 #ifdef DEBUG_OUTPUT
     debug() << "new context" <<  eom;
 #endif
@@ -38,6 +94,8 @@ void incremental_solvert::new_context()
 
 void incremental_solvert::pop_context()
 {
+  assert(context_depth>0);
+  context_depth--;
 #ifdef NON_INCREMENTAL
   assert(!contexts.empty());
 
@@ -50,12 +108,28 @@ void incremental_solvert::pop_context()
 #else
 
   solver->pop();
+  if(record_constraints)
+    contexts.pop_back();
 #ifdef DEBUG_OUTPUT
     debug() << "pop context" << eom;
 #endif
 #endif
 }
 
+/// Pops all open contexts, which disables the constraints added in them,
+/// and resets the statistics so that the solver can be reused.
+/// Domain numbers are not reset to keep the symbols of domains unique.
+void incremental_solvert::reset()
+{
+  while(context_depth>0)
+    pop_context();
+  record_constraints=false;
+  contexts.clear();
+  contexts.push_back(constraintst());
+  formula.clear();
+  solver_calls=0;
+}
+
 void incremental_solvert::debug_add_to_formula(const exprt &expr)
 {
 #ifdef NON_INCREMENTAL
@@ -38,14 +38,18 @@ class incremental_solvert:public messaget
   explicit incremental_solvert(
     const namespacet &_ns,
     message_handlert &_message_handler,
-    bool _arith_refinement=false):
+    bool _arith_refinement=false,
+    const std::string &_sat_solver=""):
     messaget(_message_handler),
     sat_check(NULL),
     solver(NULL),
     ns(_ns),
     activation_literal_counter(0),
     domain_number(0),
+    context_depth(0),
+    record_constraints(false),
     arith_refinement(_arith_refinement),
+    sat_solver(_sat_solver),
     solver_calls(0)
   {
     allocate_solvers(_arith_refinement);
@@ -107,17 +111,29 @@ class incremental_solvert:public messaget
   literalt convert(const exprt& expr) { return solver->convert(expr); }
 
   unsigned get_number_of_solver_calls() { return solver_calls; }
+  // for counting the calls done in worker processes
+  void add_solver_calls(unsigned calls) { solver_calls+=calls; }
+
+  bool uses_arith_refinement() const { return arith_refinement; }
+  const std::string &get_sat_solver() const { return sat_solver; }
 
   unsigned next_domain_number() { return domain_number++; }
 
   static incremental_solvert *allocate(
     const namespacet &_ns,
     message_handlert &_message_handler,
-    bool arith_refinement=false)
+    bool arith_refinement=false,
+    const std::string &sat_solver="")
   {
-    return new incremental_solvert(_ns, _message_handler, arith_refinement);
+    return new incremental_solvert(
+      _ns, _message_handler, arith_refinement, sat_solver);
   }
 
+  static propt *allocate_sat_check(
+    const std::string &sat_solver,
+    message_handlert &message_handler);
+  static bool is_sat_solver_available(const std::string &sat_solver);
+
   inline prop_convt & get_solver() { return *solver; }
 
   propt *sat_check;
@@ -126,6 +142,7 @@ class incremental_solvert:public messaget
 
   void new_context();
   void pop_context();
+  void reset();
 
   // for debugging
   bvt formula;
@@ -133,6 +150,10 @@ class incremental_solvert:public messaget
 
   // non-incremental solving
   contextst contexts;
+  // keep the constraints in contexts also in incremental solving
+  // (e.g. for passing the formula to an external solver), must be set
+  // before any constraint is added
+  bool record_constraints;
 
  protected:
 #ifndef DEBUG
@@ -140,7 +161,10 @@ class incremental_solvert:public messaget
 #endif
   unsigned activation_literal_counter;
   unsigned domain_number; // ids for each domain instance to make symbols unique
+  unsigned context_depth; // number of contexts that have not been popped
   bool arith_refinement;
+  // SAT solver backend, empty for the default one
+  std::string sat_solver;
 
   // statistics
   unsigned solver_calls;
@@ -148,13 +172,11 @@ class incremental_solvert:public messaget
   void allocate_solvers(bool arith_refinement)
   {
 #ifdef DEBUG
-    sat_check=new satcheckt(get_message_handler());
+    sat_check=allocate_sat_check(sat_solver, get_message_handler());
 #else
-    sat_check=new satcheckt(null_message_handler);
-#endif
-#if 0
-    sat_check=new satcheck_minisat_no_simplifiert();
+    sat_check=allocate_sat_check(sat_solver, null_message_handler);
 #endif
+    assert(sat_check!=NULL);
 #ifdef NON_INCREMENTAL
     solver=new bv_pointerst(ns, *sat_check);
 #else
@@ -194,6 +216,8 @@ static inline incremental_solvert &operator<<(
 #ifdef NON_INCREMENTAL
   dest.contexts.back().push_back(src);
 #else
+  if(dest.record_constraints)
+    dest.contexts.back().push_back(src);
 #ifndef DEBUG_FORMULA
   *dest.solver << src;
 #else
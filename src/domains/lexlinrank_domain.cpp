@@ -15,6 +15,7 @@ Author: Peter Schrammel
 
 #include <util/find_symbols.h>
 #include <util/simplify_expr.h>
+#include <util/message.h>
 #include <util/bitvector_types.h>
 #include <goto-programs/adjust_float_expressions.h>
 
@@ -43,13 +44,18 @@ void lexlinrank_domaint::initialize_value(domaint::valuet &value)
 
 void lexlinrank_domaint::initialize()
 {
-  delete inner_solver;
-  inner_solver=incremental_solvert::allocate(ns, message_handler);
+  solver_poolt::get().release(inner_solver);
+  inner_solver=solver_poolt::get().acquire(ns, message_handler);
+  lp_transitions.clear();
+  lp_fallback_rows.clear();
 }
 
 bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
 {
   auto &rank=dynamic_cast<lexlinrank_domaint::templ_valuet &>(inv);
+  if(lp_engine && edit_row_lp(row, rank, improved))
+    return improved;
+
   lexlinrank_domaint::row_valuet symb_values;
   symb_values.resize(rank[row].size());
 
@@ -133,8 +139,8 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
       else
       {
         number_elements_per_row[row]++;
-        delete inner_solver;
-        inner_solver=incremental_solvert::allocate(ns, message_handler);
+        solver_poolt::get().release(inner_solver);
+        inner_solver=solver_poolt::get().acquire(ns, message_handler);
         reset_refinements();
 
         rank[row].add_element();
@@ -146,6 +152,65 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
   return improved;
 }
 
+/// Computes a lexicographic ranking function for all transitions seen so
+/// far for the row by linear programming.
+/// \return false if the SAT-based search must be used instead because the
+///   transitions are not over integers or the coefficients do not fit
+bool lexlinrank_domaint::edit_row_lp(
+  const rowt &row,
+  templ_valuet &rank,
+  bool &improved)
+{
+  if(lp_fallback_rows.find(row)!=lp_fallback_rows.end())
+    return false;
+
+  messaget log(message_handler);
+  ranking_lpt::vectort transition;
+  if(!ranking_lpt::get_transition(smt_model_values, transition))
+  {
+    log.debug() << "LP ranking: transition of row " << row
+                << " not over integers, using SAT" << messaget::eom;
+    lp_fallback_rows.insert(row);
+    return false;
+  }
+  auto &transitions=lp_transitions[row];
+  transitions.push_back(transition);
+
+  std::vector<ranking_lpt::vectort> components;
+  if(transitions.size()>max_inner_iterations ||
+     !ranking_lpt::lexicographic(transitions, max_elements, components))
+  {
+    // no ranking function for the current template
+    rank[row].set_to_true();
+    return true;
+  }
+  for(const auto &coefficients : components)
+  {
+    if(!ranking_lpt::fits(coefficients, COEFF_C_SIZE))
+    {
+      log.debug() << "LP ranking: coefficients of row " << row
+                  << " do not fit, using SAT" << messaget::eom;
+      lp_fallback_rows.insert(row);
+      return false;
+    }
+  }
+
+  rank[row].clear();
+  for(const auto &coefficients : components)
+  {
+    row_value_elementt element;
+    for(const auto &c : coefficients)
+      element.c.push_back(from_integer(c, signedbv_typet(COEFF_C_SIZE)));
+    rank[row].push_back(element);
+  }
+  number_elements_per_row[row]=components.size()-1;
+  log.debug() << "LP ranking: row " << row << " ranks "
+              << transitions.size() << " transitions with "
+              << components.size() << " components" << messaget::eom;
+  improved=true;
+  return true;
+}
+
 exprt lexlinrank_domaint::to_pre_constraints(const valuet &_value)
 {
   exprt rounding_mode=symbol_exprt(
@@ -19,11 +19,14 @@ Author: Peter Schrammel
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
 #include <domains/incremental_solver.h>
+#include <domains/solver_pool.h>
 #include <util/ieee_float.h>
+#include <map>
 #include <set>
 #include <vector>
 
 #include "simple_domain.h"
+#include "ranking_lp.h"
 
 class lexlinrank_domaint:public simple_domaint
 {
@@ -102,16 +105,23 @@ public:
     replace_mapt &_renaming_map,
     unsigned _max_elements, // lexicographic components
     unsigned _max_inner_iterations,
+    bool _lp_engine,
     const namespacet &_ns,
     message_handlert &_message_handler):
     simple_domaint(_domain_number, _renaming_map, _ns),
     refinement_level(0),
     max_elements(_max_elements),
     max_inner_iterations(_max_inner_iterations),
+    lp_engine(_lp_engine),
     number_inner_iterations(0),
     message_handler(_message_handler)
   {
-    inner_solver=incremental_solvert::allocate(_ns, _message_handler);
+    inner_solver=solver_poolt::get().acquire(_ns, _message_handler);
+  }
+
+  ~lexlinrank_domaint() override
+  {
+    solver_poolt::get().release(inner_solver);
   }
 
 
@@ -123,6 +133,7 @@ public:
   void init_value_solver_iteration(domaint::valuet &rank) override;
 
   bool edit_row(const rowt &row, valuet &inv, bool improved) override;
+  bool edit_row_lp(const rowt &row, templ_valuet &rank, bool &improved);
 
   exprt to_pre_constraints(const valuet &_value) override;
 
@@ -162,10 +173,17 @@ public:
   // the "inner" solver
   const unsigned max_elements; // lexicographic components
   const unsigned max_inner_iterations;
+  // compute the coefficients by linear programming instead
+  const bool lp_engine;
   incremental_solvert *inner_solver;
   unsigned number_inner_iterations;
   message_handlert &message_handler;
 
+  // transitions (pre-post) seen so far for each row
+  std::map<rowt, std::vector<ranking_lpt::vectort>> lp_transitions;
+  // rows with transitions that are not over integers
+  std::set<rowt> lp_fallback_rows;
+
   std::vector<unsigned> number_elements_per_row;
 };
 
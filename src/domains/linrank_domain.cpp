@@ -15,6 +15,7 @@ Author: Peter Schrammel
 
 #include <util/find_symbols.h>
 #include <util/simplify_expr.h>
+#include <util/message.h>
 #include <util/cprover_prefix.h>
 #include <util/bitvector_types.h>
 #include <goto-programs/adjust_float_expressions.h>
@@ -41,6 +42,9 @@ void linrank_domaint::initialize_value(domaint::valuet &value)
 bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
 {
   auto &rank=dynamic_cast<linrank_domaint::templ_valuet &>(inv);
+  if(lp_engine && edit_row_lp(row, rank, improved))
+    return improved;
+
   exprt rounding_mode=symbol_exprt(
     CPROVER_PREFIX "rounding_mode",
     signedbv_typet(32));
@@ -107,6 +111,55 @@ bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
   return improved;
 }
 
+/// Computes coefficients that decrease all transitions seen so far for the
+/// row by linear programming.
+/// \return false if the SAT-based search must be used instead because the
+///   transitions are not over integers or the coefficients do not fit
+bool linrank_domaint::edit_row_lp(
+  const rowt &row,
+  templ_valuet &rank,
+  bool &improved)
+{
+  if(lp_fallback_rows.find(row)!=lp_fallback_rows.end())
+    return false;
+
+  messaget log(message_handler);
+  ranking_lpt::vectort transition;
+  if(!ranking_lpt::get_transition(smt_model_values, transition))
+  {
+    log.debug() << "LP ranking: transition of row " << row
+                << " not over integers, using SAT" << messaget::eom;
+    lp_fallback_rows.insert(row);
+    return false;
+  }
+  auto &transitions=lp_transitions[row];
+  transitions.push_back(transition);
+
+  ranking_lpt::vectort coefficients;
+  if(transitions.size()>max_inner_iterations ||
+     !ranking_lpt::linear(transitions, coefficients))
+  {
+    // no ranking function for the current template
+    rank[row].set_to_true();
+    return true;
+  }
+  if(!ranking_lpt::fits(coefficients, COEFF_C_SIZE))
+  {
+    log.debug() << "LP ranking: coefficients of row " << row
+                << " do not fit, using SAT" << messaget::eom;
+    lp_fallback_rows.insert(row);
+    return false;
+  }
+
+  rank[row].c.clear();
+  for(const auto &c : coefficients)
+    rank[row].c.push_back(from_integer(c, signedbv_typet(COEFF_C_SIZE)));
+  log.debug() << "LP ranking: row " << row << " ranks "
+              << transitions.size() << " transitions" << messaget::eom;
+  improved=true;
+  return true;
+}
+
 exprt linrank_domaint::to_pre_constraints(const valuet &_value)
 {
   exprt rounding_mode=symbol_exprt(
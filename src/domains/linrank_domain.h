@@ -20,10 +20,13 @@ Author: Peter Schrammel
 #include <util/arith_tools.h>
 #include <util/ieee_float.h>
 #include <domains/incremental_solver.h>
+#include <domains/solver_pool.h>
+#include <map>
 #include <set>
 #include <vector>
 
 #include "simple_domain.h"
+#include "ranking_lp.h"
 
 class linrank_domaint:public simple_domaint
 {
@@ -79,22 +82,30 @@ public:
     replace_mapt &_renaming_map,
     unsigned _max_elements, // lexicographic components
     unsigned _max_inner_iterations,
+    bool _lp_engine,
     const namespacet &_ns,
     message_handlert &_message_handler):
     simple_domaint(_domain_number, _renaming_map, _ns),
     refinement_level(0),
     max_elements(_max_elements),
     max_inner_iterations(_max_inner_iterations),
+    lp_engine(_lp_engine),
     number_inner_iterations(0),
     message_handler(_message_handler)
   {
-    inner_solver=incremental_solvert::allocate(_ns, _message_handler);
+    inner_solver=solver_poolt::get().acquire(_ns, _message_handler);
+  }
+
+  ~linrank_domaint() override
+  {
+    solver_poolt::get().release(inner_solver);
   }
 
   // initialize value
   void initialize_value(domaint::valuet &value) override;
 
   bool edit_row(const rowt &row, valuet &inv, bool improved) override;
+  bool edit_row_lp(const rowt &row, templ_valuet &rank, bool &improved);
 
   exprt to_pre_constraints(const valuet &_value) override;
 
@@ -132,9 +143,16 @@ public:
   // the "inner" solver
   const unsigned max_elements; // lexicographic components
   const unsigned max_inner_iterations;
+  // compute the coefficients by linear programming instead
+  const bool lp_engine;
   incremental_solvert *inner_solver;
   unsigned number_inner_iterations;
   message_handlert &message_handler;
+
+  // transitions (pre-post) seen so far for each row
+  std::map<rowt, std::vector<ranking_lpt::vectort>> lp_transitions;
+  // rows with transitions that are not over integers
+  std::set<rowt> lp_fallback_rows;
 };
 
 #endif // CPROVER_2LS_DOMAINS_LINRANK_DOMAIN_H
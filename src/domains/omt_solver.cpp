@@ -0,0 +1,142 @@
+/*******************************************************************\
+
+Module: Maximisation by an external OMT solver
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Maximisation by an external OMT solver
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/expr_util.h>
+#include <util/run.h>
+#include <util/string_utils.h>
+#include <util/tempfile.h>
+
+#include <solvers/smt2/smt2_conv.h>
+
+#include "omt_solver.h"
+
+#define OBJECTIVE_ID "2ls::omt::objective"
+
+/// Computes the maximal value of the objective such that the constraints
+/// of all contexts of the given solver are satisfiable.
+/// \param solver: incremental solver recording its constraints
+/// \param objective: term to maximise (signed or unsigned bit-vector)
+/// \param result: the maximum
+/// \return false if the maximum could not be computed, e.g. because the
+///   constraints contain SAT literals or the solver is not available
+bool omt_solvert::maximize(
+  const incremental_solvert &solver,
+  const exprt &objective,
+  constant_exprt &result)
+{
+  if(!available || !solver.record_constraints)
+    return false;
+
+  const typet &type=objective.type();
+  if(type.id()!=ID_signedbv && type.id()!=ID_unsignedbv)
+    return false;
+  std::size_t width=to_bitvector_type(type).get_width();
+
+  for(const auto &context : solver.contexts)
+    for(const auto &constraint : context)
+      if(has_subexpr(constraint, ID_literal))
+        return false;
+
+  std::string smt2_file=get_temporary_file("2ls_omt_", ".smt2");
+  std::string output_file=get_temporary_file("2ls_omt_", ".out");
+
+  {
+    std::ofstream out(smt2_file.c_str());
+    smt2_convt smt2_conv(
+      ns, "2ls", "", "QF_AUFBV", smt2_convt::solvert::Z3, out);
+    for(const auto &context : solver.contexts)
+      for(const auto &constraint : context)
+        smt2_conv.set_to_true(constraint);
+    smt2_conv.set_to_true(
+      equal_exprt(symbol_exprt(OBJECTIVE_ID, type), objective));
+
+    // bit-vector objectives are maximised as unsigned numbers, flipping
+    // the sign bit maps the order of signed numbers to the unsigned one
+    std::string objective_term="|" OBJECTIVE_ID "|";
+    if(type.id()==ID_signedbv)
+      objective_term=
+        "(bvxor "+objective_term+" #b1"+std::string(width-1, '0')+")";
+    out << "(maximize " << objective_term << ")\n"
+        << "(check-sat)\n"
+        << "(get-value (|" OBJECTIVE_ID "|))\n"
+        << "(exit)\n";
+  }
+
+  std::vector<std::string> argv;
+  split_string(command, ' ', argv, true, true);
+  argv.push_back(smt2_file);
+  int exit_code=run(argv.front(), argv, "", output_file, "");
+
+  std::ifstream in(output_file.c_str());
+  std::ostringstream output;
+  output << in.rdbuf();
+  in.close();
+
+  std::remove(smt2_file.c_str());
+  std::remove(output_file.c_str());
+
+  if(exit_code!=0 && output.str().empty())
+  {
+    warning() << "OMT solver `" << command << "' failed with exit code "
+              << exit_code << ", falling back to binary search" << eom;
+    available=false;
+    return false;
+  }
+
+  return parse_value(output.str(), type, result);
+}
+
+/// Parses the response of the solver consisting of the result of check-sat
+/// and the value of the objective.
+bool omt_solvert::parse_value(
+  const std::string &output,
+  const typet &type,
+  constant_exprt &result)
+{
+  std::istringstream in(output);
+  std::string line;
+  while(std::getline(in, line) && strip_string(line).empty()) {}
+  if(strip_string(line)!="sat")
+  {
+    debug() << "OMT solver: " << line << eom;
+    return false;
+  }
+
+  std::size_t pos=output.find(OBJECTIVE_ID "|");
+  if(pos==std::string::npos)
+    return false;
+  pos=output.find('#', pos);
+  if(pos==std::string::npos || pos+2>=output.size())
+    return false;
+
+  unsigned base;
+  if(output[pos+1]=='x')
+    base=16;
+  else if(output[pos+1]=='b')
+    base=2;
+  else
+    return false;
+  std::size_t end=output.find_first_of(" )\n", pos);
+  std::string digits=output.substr(pos+2, end-pos-2);
+  if(digits.empty())
+    return false;
+
+  mp_integer value=string2integer(digits, base);
+  result=constant_exprt(
+    integer2bvrep(value, to_bitvector_type(type).get_width()), type);
+  return true;
+}
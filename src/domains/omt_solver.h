@@ -0,0 +1,56 @@
+/*******************************************************************\
+
+Module: Maximisation by an external OMT solver
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Maximisation by an external OMT solver
+
+#ifndef CPROVER_2LS_DOMAINS_OMT_SOLVER_H
+#define CPROVER_2LS_DOMAINS_OMT_SOLVER_H
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+
+#include "incremental_solver.h"
+
+/// Computes the maximum of a bit-vector term subject to the constraints
+/// recorded by an incremental solver using an SMT solver with optimisation
+/// support (e.g. Z3 or OptiMathSAT) that is run on an SMT-LIB2 file.
+class omt_solvert:public messaget
+{
+public:
+  omt_solvert(
+    const namespacet &_ns,
+    const std::string &_command,
+    message_handlert &message_handler):
+    messaget(message_handler),
+    ns(_ns),
+    command(_command),
+    available(true)
+  {
+  }
+
+  bool maximize(
+    const incremental_solvert &solver,
+    const exprt &objective,
+    constant_exprt &result);
+
+protected:
+  const namespacet &ns;
+  /// Command line of the solver, the name of the SMT-LIB2 file is appended.
+  std::string command;
+  /// Set to false after the solver could not be run.
+  bool available;
+
+  bool parse_value(
+    const std::string &output,
+    const typet &type,
+    constant_exprt &result);
+};
+
+#endif
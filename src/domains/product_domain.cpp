@@ -22,6 +22,43 @@ void product_domaint::initialize_value(domaint::valuet &_value)
     domains[i]->initialize_value(*inv[i]);
 }
 
+/// \return Nil if any of the inner values cannot be converted
+irept product_domaint::valuet::to_irep() const
+{
+  irept irep("product_value");
+  irep.set("basic_value", static_cast<long long>(basic_value));
+  for(const auto &value : *this)
+  {
+    irept value_irep=value->to_irep();
+    if(value_irep.is_nil())
+      return get_nil_irep();
+    irep.get_sub().push_back(value_irep);
+  }
+  return irep;
+}
+
+void product_domaint::valuet::from_irep(const irept &irep)
+{
+  basic_value=static_cast<basic_valuet>(irep.get_long_long("basic_value"));
+  const irept::subt &values=irep.get_sub();
+  assert(values.size()==size());
+  for(std::size_t i=0; i<values.size(); ++i)
+    (*this)[i]->from_irep(values[i]);
+}
+
+bool product_domaint::can_seed_from(const domaint &other) const
+{
+  auto other_domain=dynamic_cast<const product_domaint *>(&other);
+  if(other_domain==nullptr || domains.size()!=other_domain->domains.size())
+    return false;
+  for(unsigned i=0; i<domains.size(); i++)
+  {
+    if(!domains[i]->can_seed_from(*other_domain->domains[i]))
+      return false;
+  }
+  return true;
+}
+
 void product_domaint::output_domain(
   std::ostream &out,
   const namespacet &ns) const
@@ -94,7 +131,7 @@ std::unique_ptr<strategy_solver_baset> product_domaint::new_strategy_solver(
       d->new_strategy_solver(solver, SSA, message_handler));
   return std::unique_ptr<strategy_solver_baset>(
     new strategy_solver_productt(
-      *this, std::move(solvers), solver, SSA, message_handler));
+      *this, std::move(solvers), solver, SSA, message_handler, parallel));
 }
 
 tpolyhedra_domaint *product_domaint::get_tpolyhedra_domain()
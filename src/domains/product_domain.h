@@ -46,6 +46,9 @@ public:
         new_value->emplace_back(val->clone());
       return new_value;
     }
+
+    irept to_irep() const override;
+    void from_irep(const irept &irep) override;
   };
 
   std::unique_ptr<domaint::valuet> new_value() override
@@ -60,6 +63,7 @@ public:
   // corresponding method is called for each domain.
 
   void initialize_value(domaint::valuet &value) override;
+  bool can_seed_from(const domaint &other) const override;
   void output_domain(std::ostream &out, const namespacet &ns) const override;
 
   void output_value(
@@ -95,6 +99,8 @@ public:
 
   // Product domain contains a vector of domains
   domain_vect domains;
+  // Iterate the inner domains in parallel processes
+  bool parallel=false;
 
   // Value is a vector of values in corresponding domains
   valuet value;
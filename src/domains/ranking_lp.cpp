@@ -0,0 +1,425 @@
+/*******************************************************************\
+
+Module: Synthesis of linear ranking functions by linear programming
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Synthesis of linear ranking functions by linear programming
+
+#include <algorithm>
+#include <cassert>
+
+#include <util/arith_tools.h>
+#include <util/std_expr.h>
+
+#include "ranking_lp.h"
+
+static bool get_integer(const exprt &expr, mp_integer &value)
+{
+  if(expr.id()!=ID_constant)
+    return false;
+  if(expr.type().id()!=ID_signedbv && expr.type().id()!=ID_unsignedbv)
+    return false;
+  return !to_integer(to_constant_expr(expr), value);
+}
+
+bool ranking_lpt::get_transition(
+  const exprt::operandst &model_values,
+  vectort &transition)
+{
+  assert(model_values.size()%2==0);
+  transition.clear();
+  for(std::size_t i=0; i+1<model_values.size(); i+=2)
+  {
+    mp_integer pre, post;
+    if(!get_integer(model_values[i], pre) ||
+       !get_integer(model_values[i+1], post))
+      return false;
+    transition.push_back(pre-post);
+  }
+  return !transition.empty();
+}
+
+bool ranking_lpt::linear(
+  const std::vector<vectort> &transitions,
+  vectort &coefficients)
+{
+  return min_norm(transitions, {}, coefficients);
+}
+
+/// Ben-Amram and Genaim's construction: each component is non-increasing
+/// on all transitions not yet ranked and decreases as many of them as
+/// possible (maximising the sum of bounded slack variables), which yields
+/// a lexicographic ranking function with the least number of components.
+bool ranking_lpt::lexicographic(
+  const std::vector<vectort> &transitions,
+  std::size_t max_components,
+  std::vector<vectort> &components)
+{
+  assert(!transitions.empty());
+  const std::size_t size=transitions.front().size();
+  std::vector<vectort> remaining=transitions;
+  components.clear();
+
+  while(!remaining.empty())
+  {
+    if(components.size()==max_components)
+      return false;
+
+    // variables: c=p-n with p, n>=0 and one slack d_t in [0, 1] for each
+    // transition t with c*t>=d_t
+    const std::size_t number_of_vars=2*size+remaining.size();
+    std::vector<constraintt> constraints;
+    rational_vectort objective(number_of_vars, rationalt(0));
+    for(std::size_t t=0; t<remaining.size(); ++t)
+    {
+      constraintt non_increasing;
+      non_increasing.coefficients.resize(number_of_vars, rationalt(0));
+      for(std::size_t i=0; i<size; ++i)
+      {
+        non_increasing.coefficients[i]=rationalt(remaining[t][i]);
+        non_increasing.coefficients[size+i]=rationalt(-remaining[t][i]);
+      }
+      non_increasing.coefficients[2*size+t]=rationalt(-1);
+      non_increasing.relation=relationt::GE;
+      non_increasing.bound=rationalt(0);
+      constraints.push_back(non_increasing);
+
+      constraintt slack_bound;
+      slack_bound.coefficients.resize(number_of_vars, rationalt(0));
+      slack_bound.coefficients[2*size+t]=rationalt(1);
+      slack_bound.relation=relationt::LE;
+      slack_bound.bound=rationalt(1);
+      constraints.push_back(slack_bound);
+
+      objective[2*size+t]=rationalt(1);
+    }
+
+    rational_vectort solution;
+    if(!maximize(number_of_vars, constraints, objective, solution))
+      return false;
+    vectort coefficients;
+    to_integers(solution, size, coefficients);
+
+    std::vector<vectort> decreasing, non_increasing;
+    for(const auto &transition : remaining)
+    {
+      if(product(coefficients, transition)>0)
+        decreasing.push_back(transition);
+      else
+        non_increasing.push_back(transition);
+    }
+    if(decreasing.empty())
+      return false;
+
+    // prefer small coefficients for the same partition
+    min_norm(decreasing, non_increasing, coefficients);
+    components.push_back(coefficients);
+    remaining.swap(non_increasing);
+  }
+
+  // the components are found from the most significant one, which is
+  // expected last
+  std::reverse(components.begin(), components.end());
+  return true;
+}
+
+bool ranking_lpt::fits(const vectort &coefficients, std::size_t width)
+{
+  const mp_integer max=power(2, width-1);
+  for(const auto &c : coefficients)
+  {
+    if(c<-max || c>=max)
+      return false;
+  }
+  return true;
+}
+
+/// Computes coefficients c with the least sum of absolute values such that
+/// c*t>=1 for the decreasing and c*t>=0 for the non-increasing transitions.
+/// \return false if there are no such coefficients
+bool ranking_lpt::min_norm(
+  const std::vector<vectort> &decreasing,
+  const std::vector<vectort> &non_increasing,
+  vectort &coefficients)
+{
+  assert(!decreasing.empty());
+  const std::size_t size=decreasing.front().size();
+
+  // c=p-n with p, n>=0
+  std::vector<constraintt> constraints;
+  for(const auto &transition : decreasing)
+  {
+    constraintt constraint;
+    for(const auto &d : transition)
+      constraint.coefficients.push_back(rationalt(d));
+    for(const auto &d : transition)
+      constraint.coefficients.push_back(rationalt(-d));
+    constraint.relation=relationt::GE;
+    constraint.bound=rationalt(1);
+    constraints.push_back(constraint);
+  }
+  for(const auto &transition : non_increasing)
+  {
+    constraintt constraint;
+    for(const auto &d : transition)
+      constraint.coefficients.push_back(rationalt(d));
+    for(const auto &d : transition)
+      constraint.coefficients.push_back(rationalt(-d));
+    constraint.relation=relationt::GE;
+    constraint.bound=rationalt(0);
+    constraints.push_back(constraint);
+  }
+
+  rational_vectort objective(2*size, rationalt(-1));
+  rational_vectort solution;
+  if(!maximize(2*size, constraints, objective, solution))
+    return false;
+  to_integers(solution, size, coefficients);
+  return true;
+}
+
+static mp_integer integer_gcd(mp_integer a, mp_integer b)
+{
+  if(a<0)
+    a=-a;
+  if(b<0)
+    b=-b;
+  while(b!=0)
+  {
+    mp_integer r=a%b;
+    a=b;
+    b=r;
+  }
+  return a;
+}
+
+/// Scales the rational coefficients c=p-n given by the solution to the
+/// least integer multiple.
+void ranking_lpt::to_integers(
+  const rational_vectort &solution,
+  std::size_t size,
+  vectort &result)
+{
+  rational_vectort c;
+  mp_integer denominator=1;
+  for(std::size_t i=0; i<size; ++i)
+  {
+    rationalt value=solution[i];
+    value-=solution[size+i];
+    c.push_back(value);
+    const mp_integer &d=value.get_denominator();
+    denominator=denominator/integer_gcd(denominator, d)*d;
+  }
+
+  result.clear();
+  mp_integer divisor=0;
+  for(const auto &value : c)
+  {
+    result.push_back(
+      value.get_numerator()*(denominator/value.get_denominator()));
+    divisor=integer_gcd(divisor, result.back());
+  }
+  if(divisor>1)
+  {
+    for(auto &value : result)
+      value/=divisor;
+  }
+}
+
+mp_integer ranking_lpt::product(
+  const vectort &coefficients,
+  const vectort &transition)
+{
+  assert(coefficients.size()==transition.size());
+  mp_integer sum=0;
+  for(std::size_t i=0; i<coefficients.size(); ++i)
+    sum+=coefficients[i]*transition[i];
+  return sum;
+}
+
+typedef std::vector<std::vector<rationalt>> tableaut;
+
+static void pivot(
+  tableaut &tableau,
+  std::vector<rationalt> &rhs,
+  std::vector<std::size_t> &basis,
+  std::size_t row,
+  std::size_t col)
+{
+  const rationalt p=tableau[row][col];
+  for(auto &a : tableau[row])
+    a/=p;
+  rhs[row]/=p;
+
+  for(std::size_t i=0; i<tableau.size(); ++i)
+  {
+    if(i==row || tableau[i][col].is_zero())
+      continue;
+    const rationalt f=tableau[i][col];
+    for(std::size_t j=0; j<tableau[i].size(); ++j)
+    {
+      rationalt a=tableau[row][j];
+      a*=f;
+      tableau[i][j]-=a;
+    }
+    rationalt b=rhs[row];
+    b*=f;
+    rhs[i]-=b;
+  }
+  basis[row]=col;
+}
+
+/// Primal simplex with Bland's rule, which guarantees termination.
+/// \return false if the objective is unbounded
+static bool simplex(
+  tableaut &tableau,
+  std::vector<rationalt> &rhs,
+  std::vector<std::size_t> &basis,
+  const std::vector<rationalt> &cost,
+  const std::vector<bool> &allowed)
+{
+  const rationalt zero(0);
+  const std::size_t cols=cost.size();
+  const std::size_t rows=tableau.size();
+
+  while(true)
+  {
+    std::size_t entering=cols;
+    for(std::size_t j=0; j<cols && entering==cols; ++j)
+    {
+      if(!allowed[j])
+        continue;
+      rationalt reduced=cost[j];
+      for(std::size_t i=0; i<rows; ++i)
+      {
+        rationalt a=cost[basis[i]];
+        a*=tableau[i][j];
+        reduced-=a;
+      }
+      if(reduced>zero)
+        entering=j;
+    }
+    if(entering==cols)
+      return true;
+
+    std::size_t leaving=rows;
+    rationalt best_ratio;
+    for(std::size_t i=0; i<rows; ++i)
+    {
+      if(!(tableau[i][entering]>zero))
+        continue;
+      rationalt ratio=rhs[i];
+      ratio/=tableau[i][entering];
+      if(leaving==rows || ratio<best_ratio ||
+         (ratio==best_ratio && basis[i]<basis[leaving]))
+      {
+        leaving=i;
+        best_ratio=ratio;
+      }
+    }
+    if(leaving==rows)
+      return false;
+
+    pivot(tableau, rhs, basis, leaving, entering);
+  }
+}
+
+/// Maximises the objective over non-negative variables subject to the
+/// constraints using the two-phase simplex method over the rationals.
+/// \return false if the constraints are infeasible or the objective is
+///   unbounded
+bool ranking_lpt::maximize(
+  std::size_t number_of_vars,
+  const std::vector<constraintt> &constraints,
+  const rational_vectort &objective,
+  rational_vectort &solution)
+{
+  const rationalt zero(0);
+
+  // standard form with non-negative right-hand sides
+  std::vector<constraintt> rows=constraints;
+  std::size_t cols=number_of_vars;
+  for(auto &row : rows)
+  {
+    assert(row.coefficients.size()==number_of_vars);
+    if(row.bound<zero)
+    {
+      for(auto &a : row.coefficients)
+        a.negate();
+      row.bound.negate();
+      if(row.relation==relationt::LE)
+        row.relation=relationt::GE;
+      else if(row.relation==relationt::GE)
+        row.relation=relationt::LE;
+    }
+    // slack, or surplus and artificial, or artificial variable
+    cols+=row.relation==relationt::GE ? 2 : 1;
+  }
+
+  tableaut tableau(rows.size(), rational_vectort(cols, zero));
+  rational_vectort rhs(rows.size());
+  std::vector<std::size_t> basis(rows.size());
+  std::vector<bool> artificial(cols, false);
+  std::size_t col=number_of_vars;
+  for(std::size_t i=0; i<rows.size(); ++i)
+  {
+    std::copy(
+      rows[i].coefficients.begin(),
+      rows[i].coefficients.end(),
+      tableau[i].begin());
+    rhs[i]=rows[i].bound;
+    if(rows[i].relation==relationt::GE)
+      tableau[i][col++]=rationalt(-1);
+    tableau[i][col]=rationalt(1);
+    artificial[col]=rows[i].relation!=relationt::LE;
+    basis[i]=col++;
+  }
+
+  // phase 1: minimise the sum of the artificial variables
+  rational_vectort cost(cols, zero);
+  for(std::size_t j=0; j<cols; ++j)
+  {
+    if(artificial[j])
+      cost[j]=rationalt(-1);
+  }
+  simplex(tableau, rhs, basis, cost, std::vector<bool>(cols, true));
+  for(std::size_t i=0; i<rows.size(); ++i)
+  {
+    if(!artificial[basis[i]])
+      continue;
+    if(!rhs[i].is_zero())
+      return false;
+
+    // drive the artificial variable out of the basis
+    for(std::size_t j=0; j<cols; ++j)
+    {
+      if(!artificial[j] && !tableau[i][j].is_zero())
+      {
+        pivot(tableau, rhs, basis, i, j);
+        break;
+      }
+    }
+  }
+
+  // phase 2: optimise the objective
+  std::vector<bool> allowed(cols);
+  for(std::size_t j=0; j<cols; ++j)
+  {
+    cost[j]=j<number_of_vars ? objective[j] : zero;
+    allowed[j]=!artificial[j];
+  }
+  if(!simplex(tableau, rhs, basis, cost, allowed))
+    return false;
+
+  solution.assign(number_of_vars, zero);
+  for(std::size_t i=0; i<rows.size(); ++i)
+  {
+    if(basis[i]<number_of_vars)
+      solution[basis[i]]=rhs[i];
+  }
+  return true;
+}
@@ -0,0 +1,90 @@
+/*******************************************************************\
+
+Module: Synthesis of linear ranking functions by linear programming
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Synthesis of linear ranking functions by linear programming
+
+#ifndef CPROVER_2LS_DOMAINS_RANKING_LP_H
+#define CPROVER_2LS_DOMAINS_RANKING_LP_H
+
+#include <vector>
+
+#include <util/expr.h>
+#include <util/mp_arith.h>
+#include <util/rational.h>
+
+/// Synthesizes (lexicographic) linear ranking functions for a finite set of
+/// transitions of a loop using an exact rational simplex. A transition is
+/// given by the differences pre-post of the values of the loop variables.
+/// This replaces the bit-blasted search for coefficients of the ranking
+/// function domains for transitions over integer (bit-vector) variables.
+class ranking_lpt
+{
+public:
+  typedef std::vector<mp_integer> vectort;
+
+  /// Computes the differences pre-post from the model values of a
+  /// transition given as successive pairs of pre- and post-values.
+  /// \return false if some value is not an integer constant (e.g. a float)
+  static bool get_transition(
+    const exprt::operandst &model_values,
+    vectort &transition);
+
+  /// Computes integer coefficients c such that c*t>0 for all transitions t.
+  /// \return false if there is no such linear ranking function
+  static bool linear(
+    const std::vector<vectort> &transitions,
+    vectort &coefficients);
+
+  /// Computes at most max_components linear components, the most
+  /// significant one last, such that each transition is decreased by
+  /// some component and not increased by the more significant ones.
+  /// \return false if there is no such lexicographic ranking function
+  static bool lexicographic(
+    const std::vector<vectort> &transitions,
+    std::size_t max_components,
+    std::vector<vectort> &components);
+
+  /// \return true if all coefficients fit in a signed bit-vector of the
+  ///   given width
+  static bool fits(const vectort &coefficients, std::size_t width);
+
+protected:
+  typedef std::vector<rationalt> rational_vectort;
+
+  enum class relationt { LE, GE, EQ };
+
+  struct constraintt
+  {
+    rational_vectort coefficients;
+    relationt relation;
+    rationalt bound;
+  };
+
+  static bool min_norm(
+    const std::vector<vectort> &decreasing,
+    const std::vector<vectort> &non_increasing,
+    vectort &coefficients);
+
+  static bool maximize(
+    std::size_t number_of_vars,
+    const std::vector<constraintt> &constraints,
+    const rational_vectort &objective,
+    rational_vectort &solution);
+
+  static void to_integers(
+    const rational_vectort &solution,
+    std::size_t size,
+    vectort &result);
+
+  static mp_integer product(
+    const vectort &coefficients,
+    const vectort &transition);
+};
+
+#endif // CPROVER_2LS_DOMAINS_RANKING_LP_H
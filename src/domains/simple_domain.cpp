@@ -106,6 +106,55 @@ void simple_domaint::templatet::output(
   }
 }
 
+/// Removes the unwinding suffixes (see ssa_local_unwindert::unwinder_rename)
+/// from the identifiers of all symbols in the expression.
+static exprt strip_unwinding_suffixes(exprt expr)
+{
+  for(auto it=expr.depth_begin(); it!=expr.depth_end(); ++it)
+  {
+    if(it->id()!=ID_symbol)
+      continue;
+    const std::string id=id2string(to_symbol_expr(*it).get_identifier());
+    std::size_t pos=id.find('%');
+    if(pos!=std::string::npos)
+      to_symbol_expr(it.mutate()).set_identifier(id.substr(0, pos));
+  }
+  return expr;
+}
+
+/// Tells whether the template is equal to the template of the other domain up
+/// to the unwinding suffixes of the SSA variables, which holds for templates
+/// of the same function generated for different unwindings.
+bool simple_domaint::same_template(const simple_domaint &other) const
+{
+  if(templ.size()!=other.templ.size())
+    return false;
+
+  for(rowt row=0; row<templ.size(); row++)
+  {
+    const template_rowt &templ_row=templ[row];
+    const template_rowt &other_row=other.templ[row];
+    if(templ_row.guards.kind!=other_row.guards.kind ||
+       strip_unwinding_suffixes(templ_row.guards.pre_guard)!=
+       strip_unwinding_suffixes(other_row.guards.pre_guard) ||
+       strip_unwinding_suffixes(templ_row.guards.post_guard)!=
+       strip_unwinding_suffixes(other_row.guards.post_guard))
+      return false;
+
+    std::vector<exprt> row_exprs=templ_row.expr->get_row_exprs();
+    std::vector<exprt> other_exprs=other_row.expr->get_row_exprs();
+    if(row_exprs.size()!=other_exprs.size())
+      return false;
+    for(std::size_t i=0; i<row_exprs.size(); i++)
+    {
+      if(strip_unwinding_suffixes(row_exprs[i])!=
+         strip_unwinding_suffixes(other_exprs[i]))
+        return false;
+    }
+  }
+  return true;
+}
+
 /// Return guard-invariant pairs for invariants contained in the given value
 /// Default behaviour: for each template row, return one pair (loop select
 /// guard, row_expr) where loop select guard is expected to be the first
@@ -80,6 +80,11 @@ public:
   /// Every domain should implement this function.
   virtual bool edit_row(const rowt &row, valuet &inv, bool improved)=0;
 
+  /// Domain should return true if all models of the post constraints should
+  /// be enumerated in a single strategy solver iteration (using blocking
+  /// constraints) instead of improving the invariant by a single model.
+  virtual bool enumerate_models() const { return false; }
+
   /// Get expression that should be made permanent in the SMT solver.
   /// This method is called after each iteration of strategy solver.
   virtual exprt get_permanent_expr(valuet &value) { return true_exprt(); }
@@ -175,6 +180,8 @@ public:
     message_handlert &message_handler) override;
 
 protected:
+  bool same_template(const simple_domaint &other) const;
+
   // handles on values to retrieve from model
   // each row has a condition literal and a vector of value expressions
   bvt strategy_cond_literals;
@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Pool of Incremental Solvers
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Pool of Incremental Solvers
+
+#include "solver_pool.h"
+
+/// Returns a solver for the given configuration, either a recycled one or
+/// a newly allocated one. The solver must be returned by \ref release.
+incremental_solvert *solver_poolt::acquire(
+  const namespacet &ns,
+  message_handlert &message_handler,
+  bool arith_refinement,
+  const std::string &sat_solver)
+{
+  incremental_solvert *solver;
+  auto &solvers=pool[configt(&ns, arith_refinement, sat_solver)];
+  if(!solvers.empty())
+  {
+    solver=solvers.back();
+    solvers.pop_back();
+    solver->set_message_handler(message_handler);
+    reuses++;
+  }
+  else
+  {
+    solver=incremental_solvert::allocate(
+      ns, message_handler, arith_refinement, sat_solver);
+    allocations++;
+  }
+
+  // all constraints of the user are added to this context
+  solver->new_context();
+  return solver;
+}
+
+/// Disables all constraints of the solver and keeps it for reuse unless
+/// it has grown too large.
+void solver_poolt::release(incremental_solvert *solver)
+{
+  if(solver==nullptr)
+    return;
+
+  solver->reset();
+
+  auto &solvers=pool[configt(
+    &solver->ns, solver->uses_arith_refinement(), solver->get_sat_solver())];
+  if(solver->sat_check->no_variables()>max_variables ||
+     solvers.size()>=max_pooled)
+  {
+    delete solver;
+    discards++;
+    return;
+  }
+  solvers.push_back(solver);
+}
+
+void solver_poolt::clear()
+{
+  for(auto &solvers : pool)
+  {
+    for(auto &solver : solvers.second)
+      delete solver;
+  }
+  pool.clear();
+}
+
+void solver_poolt::clear(const namespacet &ns)
+{
+  for(auto it=pool.begin(); it!=pool.end();)
+  {
+    if(std::get<0>(it->first)==&ns)
+    {
+      for(auto &solver : it->second)
+        delete solver;
+      it=pool.erase(it);
+    }
+    else
+      ++it;
+  }
+}
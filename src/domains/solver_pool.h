@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Pool of Incremental Solvers
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Pool of Incremental Solvers
+
+#ifndef CPROVER_2LS_DOMAINS_SOLVER_POOL_H
+#define CPROVER_2LS_DOMAINS_SOLVER_POOL_H
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "incremental_solver.h"
+
+/// Hands out incremental solvers and recycles the released ones instead of
+/// allocating a new SAT solver and bit-vector solver each time.
+/// A solver is handed out with a fresh context in which all constraints of
+/// its user are added. Releasing the solver pops this context, which
+/// disables all the constraints, hence the solver is equivalent to a new
+/// one. Solvers that have grown too large are deallocated on release.
+class solver_poolt
+{
+public:
+  static solver_poolt &get()
+  {
+    static solver_poolt pool;
+    return pool;
+  }
+
+  incremental_solvert *acquire(
+    const namespacet &ns,
+    message_handlert &message_handler,
+    bool arith_refinement=false,
+    const std::string &sat_solver="");
+  void release(incremental_solvert *solver);
+
+  /// Deallocates all solvers in the pool
+  void clear();
+  /// Deallocates the solvers in the pool that use the given namespace.
+  /// Must be called before the namespace is destroyed.
+  void clear(const namespacet &ns);
+
+  // statistics
+  unsigned allocations=0;
+  unsigned reuses=0;
+  unsigned discards=0;
+
+  /// Solvers with more SAT variables are not recycled
+  std::size_t max_variables=1000000;
+  /// Maximum number of recycled solvers for each configuration
+  std::size_t max_pooled=8;
+
+protected:
+  solver_poolt()=default;
+  ~solver_poolt() { clear(); }
+
+  // namespace, arithmetic refinement, SAT solver backend
+  typedef std::tuple<const namespacet *, bool, std::string> configt;
+  typedef std::vector<incremental_solvert *> solverst;
+  std::map<configt, solverst> pool;
+};
+
+#endif // CPROVER_2LS_DOMAINS_SOLVER_POOL_H
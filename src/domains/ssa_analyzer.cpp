@@ -21,6 +21,8 @@ Author: Peter Schrammel
 #include <util/mp_arith.h>
 #include <util/options.h>
 
+#include <ssa/profiler.h>
+
 #include "strategy_solver_base.h"
 #include "strategy_solver_binsearch.h"
 #include "strategy_solver_binsearch2.h"
@@ -78,13 +80,30 @@ void ssa_analyzert::operator()(
 
   // Get a strategy solver and a new abstract value (invariant)
   auto s_solver=domain->new_strategy_solver(solver, SSA, get_message_handler());
-  result=domain->new_value();
 
   // initialize inv
-  domain->initialize_value(*result);
+  if(seed_domain!=nullptr && domain->can_seed_from(*seed_domain))
+  {
+    result.reset(seed_value->clone());
+    profilert::get().add_count("seeded_analyses", SSA.function_identifier, 1);
+    debug() << "Starting from the previously computed invariant" << eom;
+  }
+  else
+  {
+    result=domain->new_value();
+    domain->initialize_value(*result);
+  }
 
   // iterate
-  while(s_solver->iterate(*result)) {}
+  {
+    profilert::scoped_timert timer(
+      "strategy_iteration", SSA.function_identifier);
+    std::size_t iterations=1;
+    while(s_solver->iterate(*result))
+      iterations++;
+    profilert::get().add_count(
+      "strategy_iterations", SSA.function_identifier, iterations);
+  }
 
   solver.pop_context();
 
@@ -34,6 +34,15 @@ public:
 
   void get_result(exprt &result, const var_sett &vars);
 
+  /// Starts strategy iteration from the given value of the given domain
+  /// instead of from bottom if the domains allow it (see
+  /// domaint::can_seed_from).
+  void set_seed(const domaint &domain, domaint::valuet &value)
+  {
+    seed_domain=&domain;
+    seed_value=&value;
+  }
+
   inline unsigned get_number_of_solver_instances() { return solver_instances; }
   inline unsigned get_number_of_solver_calls() { return solver_calls; }
   std::unique_ptr<domaint::valuet> get_abstract_value()
@@ -45,6 +54,9 @@ protected:
   domaint *domain; // template generator is responsible for the domain object
   std::unique_ptr<domaint::valuet> result;
 
+  const domaint *seed_domain=nullptr;
+  domaint::valuet *seed_value=nullptr;
+
   // statistics
   unsigned solver_instances;
   unsigned solver_calls;
@@ -32,7 +32,8 @@ class strategy_solver_baset:public messaget
     solver(_solver),
     SSA(SSA),
     solver_instances(0),
-    solver_calls(0) {}
+    solver_calls(0),
+    with_sympaths(false) {}
 
   virtual bool iterate(invariantt &inv) { assert(false); }
 
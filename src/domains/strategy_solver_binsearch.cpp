@@ -109,146 +109,191 @@ bool strategy_solver_binsearcht::iterate(invariantt &_inv)
 #endif
 
 
-    std::size_t row=0;
-    for(; row<tpolyhedra_domain.strategy_cond_literals.size(); row++)
+    // rows to improve with the lower bounds of their values from the model
+    std::vector<std::pair<tpolyhedra_domaint::rowt,
+                          tpolyhedra_domaint::row_valuet>> improve_rows;
+    for(std::size_t row=0;
+        row<tpolyhedra_domain.strategy_cond_literals.size(); row++)
     {
-      if(solver.l_get(tpolyhedra_domain.strategy_cond_literals[row]).is_true())
-        break;  // we've found a row to improve
+      if(!solver.l_get(
+           tpolyhedra_domain.strategy_cond_literals[row]).is_true())
+        continue;
+      improve_rows.emplace_back(
+        row,
+        tpolyhedra_domaint::row_valuet(
+          simplify_const(
+            solver.get(tpolyhedra_domain.strategy_value_exprs[row][0]))));
+      // the first row found only unless batching rows
+      if(!tpolyhedra_domain.batch_rows)
+        break;
     }
 
-    debug() << "improving row: " << row << eom;
-    std::set<tpolyhedra_domaint::rowt> improve_rows;
-    improve_rows.insert(row);
+    solver.pop_context();  // improvement check
 
-    tpolyhedra_domaint::row_valuet upper=
-      tpolyhedra_domain.get_max_row_value(row);
-    tpolyhedra_domaint::row_valuet lower=tpolyhedra_domaint::row_valuet(
-      simplify_const(
-        solver.get(tpolyhedra_domain.strategy_value_exprs[row][0])));
+    // The model of the improvement check remains a witness for the lower
+    // bound of each row when the value of other rows increases, hence all
+    // rows improvable in the model can be improved in a single iteration.
+    for(const auto &improve_row : improve_rows)
+    {
+      debug() << "improving row: " << improve_row.first << eom;
+      inv[improve_row.first]=
+        binary_search(inv, improve_row.first, improve_row.second);
+    }
+    improved=true;
+  }
+  else
+  {
+#if 0
+    debug() << "UNSAT" << eom;
+#endif
 
-    solver.pop_context();  // improvement check
+#ifdef DEBUG_FORMULA
+    for(std::size_t i=0; i<solver.formula.size(); ++i)
+    {
+      if(solver.solver->is_in_conflict(solver.formula[i]))
+        debug() << "is_in_conflict: " << solver.formula[i] << eom;
+      else
+        debug() << "not_in_conflict: " << solver.formula[i] << eom;
+    }
+#endif
+
+    solver.pop_context(); // improvement check
+  }
 
-    solver.new_context(); // symbolic value system
+  return improved;
+}
+
+/// Finds the maximal value of the given row by binary search in the symbolic
+/// value system of the row (or by the OMT solver if given).
+/// \param inv: current invariant
+/// \param row: row to improve
+/// \param lower: lower bound of the row value (value in the model of the
+///   improvement check)
+/// \return the improved row value
+tpolyhedra_domaint::row_valuet strategy_solver_binsearcht::binary_search(
+  const tpolyhedra_domaint::templ_valuet &inv,
+  const tpolyhedra_domaint::rowt &row,
+  tpolyhedra_domaint::row_valuet lower)
+{
+  std::set<tpolyhedra_domaint::rowt> improve_rows;
+  improve_rows.insert(row);
 
-    exprt pre_inv_expr=
-      tpolyhedra_domain.to_symb_pre_constraints(inv, improve_rows);
+  tpolyhedra_domaint::row_valuet upper=
+    tpolyhedra_domain.get_max_row_value(row);
 
-    solver << pre_inv_expr;
+  solver.new_context(); // symbolic value system
 
-    exprt post_inv_expr=tpolyhedra_domain.get_row_symb_post_constraint(row);
+  exprt pre_inv_expr=
+    tpolyhedra_domain.to_symb_pre_constraints(inv, improve_rows);
 
-    solver << post_inv_expr;
+  solver << pre_inv_expr;
+
+  exprt post_inv_expr=tpolyhedra_domain.get_row_symb_post_constraint(row);
+
+  solver << post_inv_expr;
 
 #if 0
-    debug() << "symbolic value system: " << eom;
-    debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
-    debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
+  debug() << "symbolic value system: " << eom;
+  debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
+  debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
 #endif
 
-    while(tpolyhedra_domain.less_than(lower, upper))
-    {
-      tpolyhedra_domaint::row_valuet middle=
-        tpolyhedra_domain.between(lower, upper);
-      if(!tpolyhedra_domain.less_than(lower, middle))
-        middle=upper;
+  // the maximum computed by the OMT solver replaces the binary search
+  tpolyhedra_domaint::row_valuet max;
+  if(omt_solver &&
+     omt_solver->maximize(
+       solver, tpolyhedra_domain.get_row_symb_value(row), max))
+  {
+    debug() << "OMT maximum: " << from_expr(SSA.ns, "", max) << eom;
+    if(tpolyhedra_domain.less_than(upper, max))
+      max=upper;
+    if(tpolyhedra_domain.less_than(lower, max))
+      lower=max;
+    upper=lower;
+  }
+
+  while(tpolyhedra_domain.less_than(lower, upper))
+  {
+    tpolyhedra_domaint::row_valuet middle=
+      tpolyhedra_domain.between(lower, upper);
+    if(!tpolyhedra_domain.less_than(lower, middle))
+      middle=upper;
 
-      // row_symb_value >= middle
-      exprt c=
-        tpolyhedra_domain.get_row_symb_value_constraint(row, middle, true);
+    // row_symb_value >= middle
+    exprt c=
+      tpolyhedra_domain.get_row_symb_value_constraint(row, middle, true);
 
 #if 0
-      debug() << "upper: " << from_expr(ns, "", upper) << eom;
-      debug() << "middle: " << from_expr(ns, "", middle) << eom;
-      debug() << "lower: " << from_expr(ns, "", lower) << eom;
+    debug() << "upper: " << from_expr(ns, "", upper) << eom;
+    debug() << "middle: " << from_expr(ns, "", middle) << eom;
+    debug() << "lower: " << from_expr(ns, "", lower) << eom;
 #endif
 
-      solver.new_context(); // binary search iteration
+    solver.new_context(); // binary search iteration
 
 #if 0
-      debug() << "constraint: " << from_expr(ns, "", c) << eom;
+    debug() << "constraint: " << from_expr(ns, "", c) << eom;
 #endif
 
-      solver << c;
+    solver << c;
 
-      if(solver()==decision_proceduret::resultt::D_SATISFIABLE)
-      {
+    if(solver()==decision_proceduret::resultt::D_SATISFIABLE)
+    {
 #if 0
-        debug() << "SAT" << eom;
+      debug() << "SAT" << eom;
 #endif
 
 #if 0
-        for(std::size_t i=0; i<tpolyhedra_domain.template_size(); i++)
-        {
-          debug() << from_expr(ns, "", tpolyhedra_domain.get_row_symb_value(i))
-                  << " " << from_expr(
-                    ns, "", solver.get(tpolyhedra_domain.get_row_symb_value(i)))
-                  << eom;
-        }
+      for(std::size_t i=0; i<tpolyhedra_domain.template_size(); i++)
+      {
+        debug() << from_expr(ns, "", tpolyhedra_domain.get_row_symb_value(i))
+                << " " << from_expr(
+                  ns, "", solver.get(tpolyhedra_domain.get_row_symb_value(i)))
+                << eom;
+      }
 #endif
 
 #if 0
-        for(const auto &rm : renaming_map)
-        {
-          debug() << "replace_map (1st): "
-                  << from_expr(ns, "", rm.first) << " "
-                  << from_expr(ns, "", solver.get(rm.first)) << eom;
-          debug() << "replace_map (2nd): "
-                  << from_expr(ns, "", rm.second) << " "
-                  << from_expr(ns, "", solver.get(rm.second)) << eom;
-        }
+      for(const auto &rm : renaming_map)
+      {
+        debug() << "replace_map (1st): "
+                << from_expr(ns, "", rm.first) << " "
+                << from_expr(ns, "", solver.get(rm.first)) << eom;
+        debug() << "replace_map (2nd): "
+                << from_expr(ns, "", rm.second) << " "
+                << from_expr(ns, "", solver.get(rm.second)) << eom;
+      }
 #endif
 
-        lower=simplify_const(
-          solver.get(tpolyhedra_domain.get_row_symb_value(row)));
-      }
-      else
-      {
+      lower=simplify_const(
+        solver.get(tpolyhedra_domain.get_row_symb_value(row)));
+    }
+    else
+    {
 #if 0
-        debug() << "UNSAT" << eom;
+      debug() << "UNSAT" << eom;
 #endif
 
 #if 0
-        for(std::size_t i=0; i<solver.formula.size(); ++i)
-        {
-          if(solver.solver->is_in_conflict(solver.formula[i]))
-            debug() << "is_in_conflict: " << solver.formula[i] << eom;
-          else
-            debug() << "not_in_conflict: " << solver.formula[i] << eom;
-        }
+      for(std::size_t i=0; i<solver.formula.size(); ++i)
+      {
+        if(solver.solver->is_in_conflict(solver.formula[i]))
+          debug() << "is_in_conflict: " << solver.formula[i] << eom;
+        else
+          debug() << "not_in_conflict: " << solver.formula[i] << eom;
+      }
 #endif
 
-        if(!tpolyhedra_domain.less_than(middle, upper))
-          middle=lower;
-        upper=middle;
-      }
-      solver.pop_context(); // binary search iteration
+      if(!tpolyhedra_domain.less_than(middle, upper))
+        middle=lower;
+      upper=middle;
     }
-
-    debug() << "update value: " << from_expr(SSA.ns, "", lower) << eom;
-
-    solver.pop_context();  // symbolic value system
-
-    inv[row]=lower;
-    improved=true;
+    solver.pop_context(); // binary search iteration
   }
-  else
-  {
-#if 0
-    debug() << "UNSAT" << eom;
-#endif
 
-#ifdef DEBUG_FORMULA
-    for(std::size_t i=0; i<solver.formula.size(); ++i)
-    {
-      if(solver.solver->is_in_conflict(solver.formula[i]))
-        debug() << "is_in_conflict: " << solver.formula[i] << eom;
-      else
-        debug() << "not_in_conflict: " << solver.formula[i] << eom;
-    }
-#endif
+  debug() << "update value: " << from_expr(SSA.ns, "", lower) << eom;
 
-    solver.pop_context(); // improvement check
-  }
+  solver.pop_context();  // symbolic value system
 
-  return improved;
+  return lower;
 }
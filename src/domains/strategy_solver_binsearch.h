@@ -12,8 +12,11 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_BINSEARCH_H
 #define CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_BINSEARCH_H
 
+#include <memory>
+
 #include "strategy_solver_base.h"
 #include "tpolyhedra_domain.h"
+#include "omt_solver.h"
 
 class strategy_solver_binsearcht:public strategy_solver_baset
 {
@@ -24,12 +27,25 @@ public:
     const local_SSAt &SSA,
     message_handlert &message_handler):
     strategy_solver_baset(_solver, SSA, message_handler),
-    tpolyhedra_domain(_tpolyhedra_domain) {}
+    tpolyhedra_domain(_tpolyhedra_domain)
+  {
+    if(!tpolyhedra_domain.omt_solver.empty())
+      omt_solver=std::unique_ptr<omt_solvert>(
+        new omt_solvert(
+          SSA.ns, tpolyhedra_domain.omt_solver, message_handler));
+  }
 
   virtual bool iterate(invariantt &inv);
 
 protected:
   tpolyhedra_domaint &tpolyhedra_domain;
+  // computes row maxima in a single query if set
+  std::unique_ptr<omt_solvert> omt_solver;
+
+  tpolyhedra_domaint::row_valuet binary_search(
+    const tpolyhedra_domaint::templ_valuet &inv,
+    const tpolyhedra_domaint::rowt &row,
+    tpolyhedra_domaint::row_valuet lower);
 };
 
 #endif
@@ -11,6 +11,21 @@ Author: Viktor Malik
 /// The strategy solver infers invariants for multiple domains in parallel
 /// (domains are side-by-side). Iteration of each domain is run in the context
 /// of candidate invariants already inferred in all other domains.
+/// In the parallel mode, the iterations of all domains are run concurrently
+/// in worker processes in the context of the candidate invariants at the
+/// start of the product iteration.
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include <util/tempfile.h>
+#include <util/irep_serialization.h>
 
 #include "strategy_solver_product.h"
 
@@ -19,6 +34,9 @@ bool strategy_solver_productt::iterate(
 {
   auto &inv=dynamic_cast<product_domaint::valuet &>(_inv);
 
+  if(parallel && can_iterate_in_parallel(inv))
+    return iterate_in_parallel(inv);
+
   bool improved=false;
   for(unsigned i=0; i<domain.domains.size(); i++)
   {
@@ -74,6 +92,148 @@ bool strategy_solver_productt::iterate(
   return improved;
 }
 
+/// The parallel mode requires values that can be passed between processes.
+/// Symbolic paths are not supported since the symbolic path found by one
+/// domain is used by the following domains.
+bool strategy_solver_productt::can_iterate_in_parallel(
+  const product_domaint::valuet &inv) const
+{
+#ifdef _WIN32
+  return false;
+#else
+  if(with_sympaths || inv.size()<2)
+    return false;
+  for(const auto &value : inv)
+  {
+    if(value->to_irep().is_nil())
+      return false;
+  }
+  return true;
+#endif
+}
+
+/// Runs one iteration of each inner domain, the first ones in worker
+/// processes and the last one in this process. All iterations run in the
+/// context of the candidate invariants at the start of this iteration
+/// (instead of the invariants improved by the preceding domains), hence they
+/// are independent. The product iteration terminates, as in the sequential
+/// mode, when no domain can be improved in the context of the others.
+bool strategy_solver_productt::iterate_in_parallel(
+  product_domaint::valuet &inv)
+{
+#ifdef _WIN32
+  assert(false);
+  return false;
+#else
+  // Candidate invariants at the start of the iteration
+  std::vector<exprt> domain_contexts(domain.domains.size());
+  for(unsigned j=0; j<domain.domains.size(); j++)
+    domain.domains[j]->project_on_vars(*inv[j], {}, domain_contexts[j]);
+
+  auto iterate_domain=[&](unsigned i)
+  {
+    solver.new_context();
+    for(unsigned j=0; j<domain.domains.size(); j++)
+    {
+      if(i!=j)
+        solver << domain_contexts[j];
+    }
+    bool domain_improved=solvers[i]->iterate(*inv[i]);
+    solver.pop_context();
+    return domain_improved;
+  };
+
+  struct workert
+  {
+    unsigned domain;
+    pid_t pid;
+    std::string file_name;
+  };
+  std::vector<workert> workers;
+
+  bool improved=false;
+  for(unsigned i=0; i+1<domain.domains.size(); i++)
+  {
+    std::string file_name=get_temporary_file("2ls_product_", ".bin");
+    std::cout.flush();
+    pid_t pid=fork();
+    if(pid==0)
+    {
+      int exit_code=0;
+      try
+      {
+        unsigned solver_calls_before=solver.get_number_of_solver_calls();
+        irept result("product_iteration");
+        result.set("improved", static_cast<long long>(iterate_domain(i)));
+        result.set(
+          "solver_calls",
+          solver.get_number_of_solver_calls()-solver_calls_before);
+        result.add("value")=inv[i]->to_irep();
+
+        std::ofstream out(file_name, std::ios::binary);
+        irep_serializationt::ireps_containert ireps_container;
+        irep_serializationt irep_serialization(ireps_container);
+        irep_serialization.reference_convert(result, out);
+        out.close();
+        if(!out)
+          exit_code=1;
+      }
+      catch(...)
+      {
+        exit_code=1;
+      }
+      std::cout.flush();
+      _exit(exit_code);
+    }
+    else if(pid<0)
+    {
+      // could not fork, iterate in this process
+      if(iterate_domain(i))
+        improved=true;
+      std::remove(file_name.c_str());
+    }
+    else
+      workers.push_back({i, pid, file_name});
+  }
+
+  if(iterate_domain(domain.domains.size()-1))
+    improved=true;
+
+  bool failed=false;
+  for(const auto &worker : workers)
+  {
+    int worker_status;
+    if(waitpid(worker.pid, &worker_status, 0)!=worker.pid ||
+       !WIFEXITED(worker_status) || WEXITSTATUS(worker_status)!=0)
+    {
+      failed=true;
+      std::remove(worker.file_name.c_str());
+      continue;
+    }
+
+    std::ifstream in(worker.file_name, std::ios::binary);
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    irept result=irep_serialization.reference_convert(in);
+    in.close();
+    std::remove(worker.file_name.c_str());
+
+    inv[worker.domain]->from_irep(result.find("value"));
+    if(result.get_long_long("improved")!=0)
+      improved=true;
+    solver.add_solver_calls(result.get_long_long("solver_calls"));
+  }
+
+  if(failed)
+    throw "product domain worker process failed";
+
+  debug() << "Iterated " << domain.domains.size() << " domains in parallel, "
+          << workers.size() << " in worker processes" << eom;
+
+  return improved;
+#endif
+}
+
 void strategy_solver_productt::use_sympaths()
 {
   strategy_solver_baset::use_sympaths();
@@ -11,6 +11,9 @@ Author: Viktor Malik
 /// The strategy solver infers invariants for multiple domains in parallel
 /// (domains are side-by-side). Iteration of each domain is run in the context
 /// of candidate invariants already inferred in all other domains.
+/// In the parallel mode, the iterations of all domains are run concurrently
+/// in worker processes in the context of the candidate invariants at the
+/// start of the product iteration.
 
 #ifndef CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_PRODUCT_H
 #define CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_PRODUCT_H
@@ -29,10 +32,12 @@ public:
     solver_vect solvers,
     incremental_solvert &solver,
     const local_SSAt &SSA,
-    message_handlert &message_handler):
+    message_handlert &message_handler,
+    bool parallel=false):
     strategy_solver_baset(solver, SSA, message_handler),
     domain(domain),
-    solvers(std::move(solvers)) {}
+    solvers(std::move(solvers)),
+    parallel(parallel) {}
 
   bool iterate(invariantt &inv) override;
 
@@ -44,6 +49,11 @@ protected:
   product_domaint &domain;
   // The solver contains a list of inner solvers
   solver_vect solvers;
+  // run the iterations of the inner domains in parallel processes
+  bool parallel;
+
+  bool can_iterate_in_parallel(const product_domaint::valuet &inv) const;
+  bool iterate_in_parallel(product_domaint::valuet &inv);
 };
 
 #endif // CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_PRODUCT_H
@@ -12,6 +12,7 @@ Author: Matej Marusak
 #include <ssa/ssa_inliner.h>
 #include "strategy_solver_simple.h"
 #include <goto-programs/adjust_float_expressions.h>
+#include <solvers/prop/literal_expr.h>
 
 bool strategy_solver_simplet::iterate(invariantt &_inv)
 {
@@ -52,27 +53,33 @@ bool strategy_solver_simplet::iterate(invariantt &_inv)
       std::cerr << "Post-condition:\n";
       debug_smt_model(cond, SSA.ns);
 #endif
-      for(std::size_t row=0; row<domain.strategy_cond_literals.size(); ++row)
+      std::vector<rowt> edited_rows;
+      improved=edit_rows(inv, edited_rows) || improved;
+
+      // Enumerate further models within the same context: the rows edited
+      // by the last model are blocked by requiring that their post-values
+      // lie outside their improved values. Not done with symbolic paths,
+      // since the models may take different paths through the loops and
+      // the symbolic path of the iteration would mix them.
+      unsigned models=1;
+      while(!with_sympaths && domain.enumerate_models() &&
+            !edited_rows.empty())
       {
-        if(solver.l_get(domain.strategy_cond_literals[row]).is_true())
+        for(const auto &row : edited_rows)
         {
-          // Retrieve values of domain strategy expressions from the model
-          // and store them into smt_model_values.
-          if(domain.strategy_value_exprs.size()>row)
-          {
-            domain.smt_model_values.clear();
-            for(auto &c_exprt : domain.strategy_value_exprs[row])
-            {
-              domain.smt_model_values.push_back(solver.solver->get(c_exprt));
-            }
-          }
-
-          if(with_sympaths)
-            find_symbolic_path(loop_guards, domain.get_current_loop_guard(row));
-
-          improved=domain.edit_row(row, inv, improved);
+          solver << implies_exprt(
+            literal_exprt(domain.strategy_cond_literals[row]),
+            domain.get_row_post_constraint(row, inv));
         }
+        if(solver()!=decision_proceduret::resultt::D_SATISFIABLE)
+          break;
+        edited_rows.clear();
+        improved=edit_rows(inv, edited_rows) || improved;
+        models++;
       }
+      if(models>1)
+        debug() << "Enumerated " << models
+                << " models in one strategy iteration" << eom;
     }
     else
     {
@@ -87,3 +94,40 @@ bool strategy_solver_simplet::iterate(invariantt &_inv)
   }
   return improved;
 }
+
+/// Edits the rows whose post constraints are satisfied by the current model.
+/// \param inv: Invariant to be improved
+/// \param edited_rows: Rows that were changed by the model
+/// \return True if the invariant was improved
+bool strategy_solver_simplet::edit_rows(
+  simple_domaint::valuet &inv,
+  std::vector<rowt> &edited_rows)
+{
+  bool improved=false;
+  for(std::size_t row=0; row<domain.strategy_cond_literals.size(); ++row)
+  {
+    if(solver.l_get(domain.strategy_cond_literals[row]).is_true())
+    {
+      // Retrieve values of domain strategy expressions from the model
+      // and store them into smt_model_values.
+      if(domain.strategy_value_exprs.size()>row)
+      {
+        domain.smt_model_values.clear();
+        for(auto &c_exprt : domain.strategy_value_exprs[row])
+        {
+          domain.smt_model_values.push_back(solver.solver->get(c_exprt));
+        }
+      }
+
+      if(with_sympaths)
+        find_symbolic_path(loop_guards, domain.get_current_loop_guard(row));
+
+      if(domain.edit_row(row, inv, false))
+      {
+        edited_rows.push_back(row);
+        improved=true;
+      }
+    }
+  }
+  return improved;
+}
@@ -34,8 +34,12 @@ public:
   bool iterate(invariantt &_inv) override;
 
 protected:
+  typedef simple_domaint::rowt rowt;
+
   simple_domaint &domain;
   std::set<std::pair<symbol_exprt, symbol_exprt>> loop_guards;
+
+  bool edit_rows(simple_domaint::valuet &inv, std::vector<rowt> &edited_rows);
 };
 
 #endif // CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_H
@@ -9,6 +9,19 @@ Author: Viktor Malik
 /// \file
 /// Generic strategy solver for domain with symbolic paths
 
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include <util/tempfile.h>
+#include <util/irep_serialization.h>
+#include <langapi/language_util.h>
+
 #include "strategy_solver_sympath.h"
 
 bool strategy_solver_sympatht::iterate(
@@ -85,11 +98,182 @@ bool strategy_solver_sympatht::iterate(
       const exprt sympath=inner_solver->symbolic_path.get_expr();
       inv.emplace(sympath, std::move(new_value));
       new_path=false;
+
+      if(jobs>1 && inv.inner_value_template->to_irep().is_not_nil())
+        start_path_worker(inv);
+    }
+    else
+    {
+      // No further path has been found, the invariants computed by the
+      // workers are added. If a worker altered its path, the elimination of
+      // the visited paths changes and the search continues.
+      while(!path_workers.empty())
+      {
+        if(collect_path_worker(inv))
+          improved=true;
+      }
     }
   }
   return improved;
 }
 
+static irept sympath_to_irep(const symbolic_patht &path)
+{
+  irept irep("symbolic_path");
+  for(const auto &guard : path.path_map)
+  {
+    irept guard_irep("guard");
+    guard_irep.set(ID_expression, guard.first);
+    guard_irep.set(ID_value, static_cast<long long>(guard.second));
+    irep.get_sub().push_back(guard_irep);
+  }
+  return irep;
+}
+
+static symbolic_patht sympath_from_irep(const irept &irep)
+{
+  symbolic_patht path;
+  for(const auto &guard_irep : irep.get_sub())
+  {
+    path[static_cast<const exprt &>(guard_irep.find(ID_expression))]=
+      guard_irep.get_long_long(ID_value)!=0;
+  }
+  return path;
+}
+
+/// Computes the invariant of the current (newly found) symbolic path in a
+/// worker process. The path is considered visited so that the search for
+/// further paths continues in this process. If the worker cannot be
+/// started, the invariant is computed in this process.
+void strategy_solver_sympatht::start_path_worker(
+  sympath_domaint::sympath_valuet &inv)
+{
+#ifndef _WIN32
+  if(path_workers.size()>=jobs)
+    collect_path_worker(inv);
+
+  std::string file_name=get_temporary_file("2ls_sympath_", ".bin");
+  std::cout.flush();
+  pid_t pid=fork();
+  if(pid==0)
+  {
+    int exit_code=0;
+    try
+    {
+      jobs=1;
+      path_workers.clear();
+      unsigned solver_calls_before=solver.get_number_of_solver_calls();
+
+      // iterate until the invariant of the path cannot be improved
+      while(!new_path)
+        iterate(inv);
+
+      irept result("path_result");
+      const symbolic_patht &path=visited_paths.back();
+      result.set("path", sympath_to_irep(path));
+      auto value=inv.find(path.get_expr());
+      if(value!=inv.end())
+        result.set("value", value->second->to_irep());
+      result.set(
+        "solver_calls",
+        solver.get_number_of_solver_calls()-solver_calls_before);
+
+      std::ofstream out(file_name, std::ios::binary);
+      irep_serializationt::ireps_containert ireps_container;
+      irep_serializationt irep_serialization(ireps_container);
+      irep_serialization.reference_convert(result, out);
+      out.close();
+      if(!out)
+        exit_code=1;
+    }
+    catch(...)
+    {
+      exit_code=1;
+    }
+    std::cout.flush();
+    _exit(exit_code);
+  }
+  else if(pid<0)
+  {
+    std::remove(file_name.c_str());
+    return;
+  }
+
+  debug() << "Started worker for symbolic path "
+          << from_expr(SSA.ns, "", symbolic_path.get_expr()) << eom;
+  path_workers.push_back({symbolic_path, pid, file_name});
+  inv.erase(symbolic_path.get_expr());
+  visited_paths.push_back(symbolic_path);
+  domain.inner_domain->remove_all_sympath_restrictions();
+  domain.inner_domain->eliminate_sympaths(visited_paths);
+  clear_symbolic_path();
+  new_path=true;
+#endif
+}
+
+/// Waits for the oldest path worker and adds the invariant of its path.
+/// \return True if the worker altered its path. The altered path replaces
+///   the original one in the visited paths, hence the original path may be
+///   found again.
+bool strategy_solver_sympatht::collect_path_worker(
+  sympath_domaint::sympath_valuet &inv)
+{
+#ifdef _WIN32
+  return false;
+#else
+  path_workert worker=path_workers.front();
+  path_workers.pop_front();
+
+  int worker_status;
+  if(waitpid(worker.pid, &worker_status, 0)!=worker.pid ||
+     !WIFEXITED(worker_status) || WEXITSTATUS(worker_status)!=0)
+  {
+    std::remove(worker.file_name.c_str());
+    throw "symbolic path worker process failed";
+  }
+
+  std::ifstream in(worker.file_name, std::ios::binary);
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_serialization(ireps_container);
+  irept result=irep_serialization.reference_convert(in);
+  in.close();
+  std::remove(worker.file_name.c_str());
+
+  solver.add_solver_calls(result.get_long_long("solver_calls"));
+
+  // infeasible paths have no invariant
+  symbolic_patht path=sympath_from_irep(result.find("path"));
+  if(result.find("value").is_not_nil())
+  {
+    auto value=std::unique_ptr<domaint::valuet>(
+      inv.inner_value_template->clone());
+    domain.inner_domain->initialize_value(*value);
+    value->from_irep(result.find("value"));
+    inv.emplace(path.get_expr(), std::move(value));
+  }
+
+  debug() << "Collected worker for symbolic path "
+          << from_expr(SSA.ns, "", worker.path.get_expr()) << eom;
+  if(path==worker.path)
+    return false;
+
+  debug() << "Worker altered symbolic path to "
+          << from_expr(SSA.ns, "", path.get_expr()) << eom;
+
+  for(auto it=visited_paths.begin(); it!=visited_paths.end(); ++it)
+  {
+    if(*it==worker.path)
+    {
+      *it=path;
+      break;
+    }
+  }
+  domain.inner_domain->remove_all_sympath_restrictions();
+  domain.inner_domain->eliminate_sympaths(visited_paths);
+  return true;
+#endif
+}
+
 void strategy_solver_sympatht::clear_symbolic_path()
 {
   strategy_solver_baset::clear_symbolic_path();
@@ -13,6 +13,9 @@ Author: Viktor Malik
 #define CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_SYMPATH_H
 
 
+#include <list>
+#include <string>
+
 #include "strategy_solver_base.h"
 #include "sympath_domain.h"
 
@@ -24,10 +27,12 @@ public:
     std::unique_ptr<strategy_solver_baset> _inner_solver,
     incremental_solvert &_solver,
     const local_SSAt &SSA,
-    message_handlert &message_handler):
+    message_handlert &message_handler,
+    unsigned _jobs=1):
     strategy_solver_baset(_solver, SSA, message_handler),
     domain(_domain),
-    inner_solver(std::move(_inner_solver))
+    inner_solver(std::move(_inner_solver)),
+    jobs(_jobs)
   {
     build_loop_conds_map(SSA);
     inner_solver->use_sympaths();
@@ -46,6 +51,20 @@ protected:
   std::vector<symbolic_patht> visited_paths;
   bool new_path=true;
 
+  // Invariants of symbolic paths are computed in up to this number of
+  // worker processes while further paths are searched for
+  unsigned jobs;
+  struct path_workert
+  {
+    // the path as found, the worker may alter it
+    symbolic_patht path;
+    int pid;
+    std::string file_name;
+  };
+  std::list<path_workert> path_workers;
+  void start_path_worker(sympath_domaint::sympath_valuet &inv);
+  bool collect_path_worker(sympath_domaint::sympath_valuet &inv);
+
   // Mapping for each loop:
   // g#ls    ->    (g#lh   &&   g#le)
   // ^ loop select  ^ loop head ^ loop end
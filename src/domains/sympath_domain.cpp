@@ -69,5 +69,5 @@ std::unique_ptr<strategy_solver_baset> sympath_domaint::new_strategy_solver(
     solver, SSA, message_handler);
   return std::unique_ptr<strategy_solver_baset>(
     new strategy_solver_sympatht(
-      *this, std::move(inner_solver), solver, SSA, message_handler));
+      *this, std::move(inner_solver), solver, SSA, message_handler, jobs));
 }
@@ -37,6 +37,8 @@ public:
   }
 
   std::unique_ptr<domaint> inner_domain;
+  // Number of processes computing invariants of symbolic paths
+  unsigned jobs=1;
 
   // Value is a map from expression (symbolic path) to an invariant in the
   // inner domain
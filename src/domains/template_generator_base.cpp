@@ -16,6 +16,7 @@ Author: Peter Schrammel
 #include <util/mp_arith.h>
 #include <util/prefix.h>
 #include <util/simplify_expr.h>
+#include <util/union_find.h>
 
 #include <ssa/dynamic_objects.h>
 #include <ssa/ssa_inliner.h>
@@ -29,6 +30,7 @@ Author: Peter Schrammel
 #include "tpolyhedra_domain.h"
 
 #include <algorithm>
+#include <map>
 
 #ifdef DEBUG
 #include <iostream>
@@ -270,6 +272,87 @@ template_generator_baset::filter_template_domain(const var_specst &var_specs)
   return new_var_specs;
 }
 
+/// Collects the non-Boolean symbols occurring in the expression, with SSA
+/// suffixes removed
+static void collect_pack_symbols(const exprt &expr, std::vector<exprt> &symbols)
+{
+  if(expr.id()==ID_symbol)
+  {
+    if(expr.type().id()!=ID_bool)
+      symbols.push_back(get_original_expr(expr));
+  }
+  else
+  {
+    for(const auto &op : expr.operands())
+      collect_pack_symbols(op, symbols);
+  }
+}
+
+/// Relates the variables occurring in the same atomic condition
+static void relate_pack_symbols(
+  const exprt &expr,
+  union_find<exprt, irep_hash> &related)
+{
+  if(expr.id()==ID_and || expr.id()==ID_or || expr.id()==ID_not ||
+     expr.id()==ID_implies)
+  {
+    for(const auto &op : expr.operands())
+      relate_pack_symbols(op, related);
+    return;
+  }
+
+  std::vector<exprt> symbols;
+  collect_pack_symbols(expr, symbols);
+  for(std::size_t i=1; i<symbols.size(); ++i)
+    related.make_union(symbols[0], symbols[i]);
+}
+
+/// Splits the variables into packs of related variables so that relational
+/// template rows are created within the packs only (with --pack-size).
+/// Variables are related if they occur in the same assignment or in the same
+/// atomic condition of the SSA. Packs larger than the pack size are split.
+/// \return A single pack with all variables if packing is not enabled
+std::vector<var_specst> template_generator_baset::pack_var_specs(
+  const var_specst &var_specs,
+  const local_SSAt &SSA)
+{
+  std::size_t pack_size=options.get_unsigned_int_option("pack-size");
+  if(pack_size==0 || var_specs.size()<=pack_size)
+    return {var_specs};
+
+  union_find<exprt, irep_hash> related;
+  for(const auto &node : SSA.nodes)
+  {
+    for(const auto &equality : node.equalities)
+      relate_pack_symbols(equality, related);
+    for(const auto &constraint : node.constraints)
+      relate_pack_symbols(constraint, related);
+    for(const auto &assertion : node.assertions)
+      relate_pack_symbols(assertion, related);
+  }
+
+  // group the variables by their classes, keeping their order
+  std::vector<var_specst> packs;
+  std::map<std::size_t, std::size_t> class_packs;
+  for(const auto &v : var_specs)
+  {
+    std::size_t var_class=related.find_number(get_original_expr(v.var));
+    auto pack=class_packs.find(var_class);
+    if(pack==class_packs.end() || packs[pack->second].size()>=pack_size)
+    {
+      class_packs[var_class]=packs.size();
+      packs.emplace_back();
+      packs.back().push_back(v);
+    }
+    else
+      packs[pack->second].push_back(v);
+  }
+
+  debug() << "Packed " << var_specs.size() << " template variables into "
+          << packs.size() << " packs" << eom;
+  return packs;
+}
+
 var_specst
 template_generator_baset::filter_equality_domain(const var_specst &var_specs)
 {
@@ -650,7 +733,8 @@ std::unique_ptr<domaint> template_generator_baset::instantiate_standard_domains(
     {
       auto new_domain =
         new tpolyhedra_domaint(domain_number++, renaming_map, SSA.ns, options);
-      new_domain->add_difference_template(templ_var_specs, SSA.ns);
+      for(const auto &pack : pack_var_specs(templ_var_specs, SSA))
+        new_domain->add_difference_template(pack, SSA.ns);
       new_domain->add_interval_template(templ_var_specs, SSA.ns);
       domains.emplace_back(new_domain);
     }
@@ -662,8 +746,11 @@ std::unique_ptr<domaint> template_generator_baset::instantiate_standard_domains(
     {
       auto new_domain =
         new tpolyhedra_domaint(domain_number++, renaming_map, SSA.ns, options);
-      new_domain->add_sum_template(templ_var_specs, SSA.ns);
-      new_domain->add_difference_template(templ_var_specs, SSA.ns);
+      auto packs = pack_var_specs(templ_var_specs, SSA);
+      for(const auto &pack : packs)
+        new_domain->add_sum_template(pack, SSA.ns);
+      for(const auto &pack : packs)
+        new_domain->add_difference_template(pack, SSA.ns);
       new_domain->add_interval_template(templ_var_specs, SSA.ns);
       domains.emplace_back(new_domain);
     }
@@ -675,7 +762,8 @@ std::unique_ptr<domaint> template_generator_baset::instantiate_standard_domains(
     {
       auto new_domain =
         new tpolyhedra_domaint(domain_number++, renaming_map, SSA.ns, options);
-      new_domain->add_difference_template(templ_var_specs, SSA.ns);
+      for(const auto &pack : pack_var_specs(templ_var_specs, SSA))
+        new_domain->add_difference_template(pack, SSA.ns);
       new_domain->add_quadratic_template(templ_var_specs, SSA.ns);
       domains.emplace_back(new_domain);
     }
@@ -687,12 +775,21 @@ std::unique_ptr<domaint> template_generator_baset::instantiate_standard_domains(
   if(domains.size()==1)
     domain = std::move(domains[0]);
   else
-    domain = std::unique_ptr<domaint>(new product_domaint(
-      domain_number++, renaming_map, SSA.ns, std::move(domains)));
+  {
+    auto product = new product_domaint(
+      domain_number++, renaming_map, SSA.ns, std::move(domains));
+    product->parallel = options.get_bool_option("parallel-product");
+    domain = std::unique_ptr<domaint>(product);
+  }
 
   if(options.get_bool_option("sympath"))
-    domain = std::unique_ptr<domaint>(new sympath_domaint(
-      domain_number++, renaming_map, SSA, std::move(domain)));
+  {
+    auto sympath_domain = new sympath_domaint(
+      domain_number++, renaming_map, SSA, std::move(domain));
+    if(options.is_set("sympath-jobs"))
+      sympath_domain->jobs = options.get_unsigned_int_option("sympath-jobs");
+    domain = std::unique_ptr<domaint>(sympath_domain);
+  }
 
   return domain;
 }
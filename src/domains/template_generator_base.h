@@ -88,6 +88,10 @@ protected:
   static var_specst filter_heap_domain(const var_specst &var_specs);
   static var_specst filter_array_domain(const var_specst &var_specs);
 
+  std::vector<var_specst> pack_var_specs(
+    const var_specst &var_specs,
+    const local_SSAt &SSA);
+
   void add_var(const vart &var,
                const guardst::guardt &pre_guard,
                guardst::guardt post_guard,
@@ -13,6 +13,7 @@ Author: Peter Schrammel
 
 #include <ssa/ssa_inliner.h>
 #include <ssa/dynamic_objects.h>
+#include <ssa/profiler.h>
 
 #include "template_generator_callingcontext.h"
 #include "equality_domain.h"
@@ -25,6 +26,8 @@ void template_generator_callingcontextt::operator()(
   local_SSAt::nodet::function_callst::const_iterator f_it,
   bool forward)
 {
+  profilert::scoped_timert timer(
+    "template_generation", SSA.function_identifier);
   domain_number=_domain_number;
   handle_special_functions(SSA); // we have to call that to prevent trouble!
 
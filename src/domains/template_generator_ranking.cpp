@@ -18,6 +18,8 @@ Author: Peter Schrammel
 #include <util/simplify_expr.h>
 #include <util/mp_arith.h>
 
+#include <ssa/profiler.h>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
@@ -27,6 +29,8 @@ void template_generator_rankingt::operator()(
   const local_SSAt &SSA,
   bool forward)
 {
+  profilert::scoped_timert timer(
+    "template_generation", SSA.function_identifier);
   domain_number=_domain_number;
   handle_special_functions(SSA); // we have to call that to prevent trouble!
 
@@ -38,6 +42,7 @@ void template_generator_rankingt::operator()(
         post_renaming_map,
         options.get_unsigned_int_option("lexicographic-ranking-function"),
         options.get_unsigned_int_option("max-inner-ranking-iterations"),
+        options.get_option("ranking-engine")=="lp",
         SSA.ns,
         get_message_handler()));
   }
@@ -49,6 +54,7 @@ void template_generator_rankingt::operator()(
         post_renaming_map,
         options.get_unsigned_int_option("lexicographic-ranking-function"),
         options.get_unsigned_int_option("max-inner-ranking-iterations"),
+        options.get_option("ranking-engine")=="lp",
         SSA.ns,
         get_message_handler()));
   }
@@ -21,6 +21,8 @@ Author: Peter Schrammel
 #include <util/simplify_expr.h>
 #include <util/mp_arith.h>
 
+#include <ssa/profiler.h>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
@@ -30,6 +32,8 @@ void template_generator_summaryt::operator()(
   const local_SSAt &SSA,
   bool forward)
 {
+  profilert::scoped_timert timer(
+    "template_generation", SSA.function_identifier);
   domain_number=_domain_number;
   handle_special_functions(SSA); // we have to call that to prevent trouble!
 
@@ -536,6 +536,23 @@ void tpolyhedra_domaint::add_sum_template(
   }
 }
 
+irept tpolyhedra_domaint::templ_valuet::to_irep() const
+{
+  irept irep("templ_value");
+  irep.set("basic_value", static_cast<long long>(basic_value));
+  for(const auto &row : *this)
+    irep.get_sub().push_back(row);
+  return irep;
+}
+
+void tpolyhedra_domaint::templ_valuet::from_irep(const irept &irep)
+{
+  basic_value=static_cast<basic_valuet>(irep.get_long_long("basic_value"));
+  clear();
+  for(const auto &row : irep.get_sub())
+    emplace_back(to_constant_expr(static_cast<const exprt &>(row)));
+}
+
 /// Choose a correct solver based on the used strategy
 std::unique_ptr<strategy_solver_baset> tpolyhedra_domaint::new_strategy_solver(
   incremental_solvert &solver,
@@ -73,6 +73,9 @@ public:
     }
 
     templ_valuet *clone() override { return new templ_valuet(*this); }
+
+    irept to_irep() const override;
+    void from_irep(const irept &irep) override;
   };
 
   std::unique_ptr<domaint::valuet> new_value() override
@@ -88,6 +91,10 @@ public:
     BINSEARCH3
   };
   strategyt strategy;
+  // improve all rows improvable in a model in one iteration (BINSEARCH)
+  bool batch_rows;
+  // command of the OMT solver computing row maxima (BINSEARCH)
+  std::string omt_solver;
 
   tpolyhedra_domaint(
     unsigned _domain_number,
@@ -95,12 +102,20 @@ public:
     const namespacet &_ns,
     const optionst &options):
     simple_domaint(_domain_number, _renaming_map, _ns),
-    strategy(options.get_bool_option("enum-solver") ? ENUMERATION : BINSEARCH)
+    strategy(options.get_bool_option("enum-solver") ? ENUMERATION : BINSEARCH),
+    batch_rows(options.get_bool_option("binsearch-batch")),
+    omt_solver(options.get_option("omt-solver"))
     {}
 
   // initialize value
   void initialize_value(domaint::valuet &value) override;
 
+  bool can_seed_from(const domaint &other) const override
+  {
+    auto other_domain=dynamic_cast<const tpolyhedra_domaint *>(&other);
+    return other_domain!=nullptr && same_template(*other_domain);
+  }
+
   bool edit_row(const rowt &row, valuet &inv, bool improved) override;
 
   void join(domaint::valuet &value1, const domaint::valuet &value2) override;
@@ -10,8 +10,23 @@ Author: Peter Schrammel
 /// Summarizer Base
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 #include <util/simplify_expr.h>
+#include <util/tempfile.h>
+#include <util/irep_serialization.h>
+#include <util/suffix.h>
 #include <solvers/sat/satcheck.h>
 #include <solvers/flattening/bv_pointers.h>
 #include <solvers/smt2/smt2_dec.h>
@@ -30,6 +45,15 @@ Author: Peter Schrammel
 
 void summarizer_baset::summarize()
 {
+  if(summarize_bottom_up_enabled())
+  {
+    function_sett functions;
+    for(const auto &f : ssa_db.functions())
+      functions.insert(f.first);
+    summarize_bottom_up(functions);
+    return;
+  }
+
   exprt precondition=true_exprt(); // initial calling context
   for(functionst::const_iterator it=ssa_db.functions().begin();
       it!=ssa_db.functions().end(); it++)
@@ -41,12 +65,21 @@ void summarizer_baset::summarize()
     else
       status() << "Summary for function " << it->first
                << " exists already" << eom;
+    ssa_db.enforce_memory_limit(summary_db);
   }
 }
 
 /// summarize from given entry point
 void summarizer_baset::summarize(const function_namet &function_name)
 {
+  if(summarize_bottom_up_enabled())
+  {
+    function_sett functions;
+    collect_reachable_functions(function_name, functions);
+    summarize_bottom_up(functions);
+    return;
+  }
+
   exprt precondition=true_exprt(); // initial calling context
 
   status() << "\nSummarizing function " << function_name << eom;
@@ -264,6 +297,12 @@ bool summarizer_baset::check_precondition(
     status() << "Function " << fname << " not found" << eom;
     precondition_holds=true;
   }
+  else if(!relevant_functions.empty() && !relevant_functions.count(fname))
+  {
+    status() << "Havoc call to " << fname
+             << ", which does not influence the properties" << eom;
+    precondition_holds=true;
+  }
   else if(fname==function_name)
   {
     status() << "Havoc recursive function call to " << fname << eom;
@@ -354,3 +393,644 @@ bool summarizer_baset::check_end_reachable(
 
   return result;
 }
+
+/// Parallel bottom-up summarization is used only when requested by --jobs
+/// and when the summaries do not need to keep their abstract domains and
+/// values (these cannot be transferred from the worker processes), which
+/// are used by --instrument-output and --reuse-invariants.
+bool summarizer_baset::summarize_bottom_up_enabled() const
+{
+  return options.get_unsigned_int_option("jobs")>1 &&
+         !options.get_bool_option("context-sensitive") &&
+         !options.get_bool_option("reuse-invariants") &&
+         options.get_option("instrument-output").empty();
+}
+
+/// Computes summaries of the given functions in the order given by the call
+/// graph. Functions in the same level do not call each other and all their
+/// callees are already summarized, so they can be analyzed independently.
+/// Since each function is analyzed with the trivial calling context and with
+/// the summaries of all its callees available (as in the sequential run),
+/// the resulting summaries are the same.
+void summarizer_baset::summarize_bottom_up(const function_sett &functions)
+{
+  call_graph_levelst levels;
+  function_sett cyclic;
+  compute_call_graph_levels(functions, levels, cyclic);
+
+  for(const auto &level : levels)
+  {
+    std::vector<function_namet> to_summarize;
+    for(const auto &f : level)
+    {
+      if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+        to_summarize.push_back(f);
+      else
+        status() << "Summary for function " << f << " exists already" << eom;
+    }
+
+    if(to_summarize.size()==1)
+    {
+      status() << "\nSummarizing function " << to_summarize.front() << eom;
+      compute_summary_rec(to_summarize.front(), true_exprt(), false);
+    }
+    else if(!to_summarize.empty())
+      summarize_in_workers(to_summarize);
+    ssa_db.enforce_memory_limit(summary_db);
+  }
+
+  // recursive functions are summarized sequentially
+  for(const auto &f : cyclic)
+  {
+    status() << "\nSummarizing function " << f << eom;
+    if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+      compute_summary_rec(f, true_exprt(), false);
+    else
+      status() << "Summary for function " << f << " exists already" << eom;
+    ssa_db.enforce_memory_limit(summary_db);
+  }
+}
+
+/// Summarizes only the functions that can influence the properties in the
+/// given goal functions, calls to the other functions are havocked.
+void summarizer_baset::summarize_goals(
+  const function_namet &entry_function,
+  const function_sett &goals)
+{
+  collect_relevant_functions(goals, relevant_functions);
+  status() << "Summarizing " << relevant_functions.size() << " of "
+           << ssa_db.functions().size()
+           << " functions relevant to the properties" << eom;
+  if(relevant_functions.empty())
+    return;
+
+  // the calling contexts are propagated from the entry function
+  if(options.get_bool_option("context-sensitive"))
+  {
+    if(relevant_functions.count(entry_function))
+      summarize(entry_function);
+    return;
+  }
+
+  if(summarize_bottom_up_enabled())
+  {
+    summarize_bottom_up(relevant_functions);
+    return;
+  }
+
+  for(const auto &f : goals)
+  {
+    status() << "\nSummarizing function " << f << eom;
+    if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+      compute_summary_rec(f, true_exprt(), false);
+    else
+      status() << "Summary for function " << f << " exists already" << eom;
+    ssa_db.enforce_memory_limit(summary_db);
+  }
+}
+
+/// Collects the goal functions and their transitive callees, whose
+/// summaries are used when checking the properties. With calling contexts,
+/// the transitive callers of the goal functions are added as well as those
+/// of their callees that may change the calling contexts by their return
+/// value, by writing through pointer parameters or by writing a global
+/// variable read by a collected function.
+void summarizer_baset::collect_relevant_functions(
+  const function_sett &goals,
+  function_sett &functions)
+{
+  std::vector<function_namet> worklist(goals.begin(), goals.end());
+
+  function_sett context_functions;
+  if(options.get_bool_option("context-sensitive"))
+  {
+    std::map<function_namet, function_sett> callers;
+    for(const auto &f : ssa_db.functions())
+    {
+      function_sett callees;
+      get_callees(f.first, callees);
+      for(const auto &callee : callees)
+        callers[callee].insert(f.first);
+    }
+
+    std::vector<function_namet> callers_worklist(worklist);
+    while(!callers_worklist.empty())
+    {
+      function_namet f=callers_worklist.back();
+      callers_worklist.pop_back();
+      for(const auto &caller : callers[f])
+      {
+        if(context_functions.insert(caller).second)
+          callers_worklist.push_back(caller);
+      }
+    }
+  }
+
+  std::set<irep_idt> globals_read;
+  for(const auto &f : context_functions)
+  {
+    functions.insert(f);
+    for(const auto &global : ssa_db.get(f).globals_in)
+      globals_read.insert(ssa_inlinert::get_original_identifier(global));
+  }
+
+  while(!worklist.empty())
+  {
+    while(!worklist.empty())
+    {
+      function_namet f=worklist.back();
+      worklist.pop_back();
+      if(!ssa_db.exists(f) ||
+         (functions.count(f) && !context_functions.count(f)))
+        continue;
+      functions.insert(f);
+      // the callees of f are all relevant now
+      context_functions.erase(f);
+
+      const local_SSAt &SSA=ssa_db.get(f);
+      for(const auto &global : SSA.globals_in)
+        globals_read.insert(ssa_inlinert::get_original_identifier(global));
+
+      function_sett callees;
+      get_callees(f, callees);
+      worklist.insert(worklist.end(), callees.begin(), callees.end());
+    }
+
+    // callees of the callers that may change the calling contexts
+    for(const auto &f : context_functions)
+    {
+      function_sett callees;
+      get_callees(f, callees);
+      for(const auto &callee : callees)
+      {
+        if(!functions.count(callee) &&
+           may_change_calling_context(callee, globals_read))
+          worklist.push_back(callee);
+      }
+    }
+  }
+}
+
+bool summarizer_baset::may_change_calling_context(
+  const function_namet &function_name,
+  const std::set<irep_idt> &globals_read)
+{
+  const local_SSAt &SSA=ssa_db.get(function_name);
+  for(const auto &param : SSA.params)
+  {
+    if(param.type().id()==ID_pointer)
+      return true;
+  }
+  for(const auto &global : SSA.globals_out)
+  {
+    irep_idt identifier=ssa_inlinert::get_original_identifier(global);
+    if(has_suffix(id2string(identifier), "#return_value") ||
+       globals_read.count(identifier))
+      return true;
+  }
+  return false;
+}
+
+/// collects the functions called from the given function that have an SSA
+void summarizer_baset::get_callees(
+  const function_namet &function_name,
+  function_sett &callees)
+{
+  const local_SSAt &SSA=ssa_db.get(function_name);
+  for(const auto &node : SSA.nodes)
+  {
+    for(const auto &call : node.function_calls)
+    {
+      if(call.function().id()!=ID_symbol)
+        continue;
+      irep_idt fname=to_symbol_expr(call.function()).get_identifier();
+      if(ssa_db.exists(fname))
+        callees.insert(fname);
+    }
+  }
+}
+
+/// collects the functions transitively called from the entry function
+void summarizer_baset::collect_reachable_functions(
+  const function_namet &entry_function,
+  function_sett &functions)
+{
+  std::vector<function_namet> worklist(1, entry_function);
+  while(!worklist.empty())
+  {
+    function_namet f=worklist.back();
+    worklist.pop_back();
+    if(!ssa_db.exists(f) || !functions.insert(f).second)
+      continue;
+
+    function_sett callees;
+    get_callees(f, callees);
+    worklist.insert(worklist.end(), callees.begin(), callees.end());
+  }
+}
+
+/// Splits the functions into levels such that all callees of a function are
+/// in lower levels. Functions that are part of a (mutual) recursion cannot
+/// be placed into any level and are returned in `cyclic`.
+void summarizer_baset::compute_call_graph_levels(
+  const function_sett &functions,
+  call_graph_levelst &levels,
+  function_sett &cyclic)
+{
+  std::map<function_namet, function_sett> callees;
+  for(const auto &f : functions)
+    get_callees(f, callees[f]);
+
+  function_sett remaining=functions;
+  while(!remaining.empty())
+  {
+    function_sett level;
+    for(const auto &f : remaining)
+    {
+      bool ready=true;
+      for(const auto &callee : callees[f])
+      {
+        // direct recursive calls are havocked
+        if(callee!=f && remaining.find(callee)!=remaining.end())
+        {
+          ready=false;
+          break;
+        }
+      }
+      if(ready)
+        level.insert(f);
+    }
+
+    if(level.empty())
+    {
+      cyclic=remaining;
+      break;
+    }
+
+    for(const auto &f : level)
+      remaining.erase(f);
+    levels.push_back(level);
+  }
+}
+
+/// Computes the summaries of independent functions in parallel worker
+/// processes. Each worker is forked from the current state, so it has
+/// the summaries of all callees and its own solvers. The resulting summaries
+/// are sent back through a temporary file and stored in the summary database.
+void summarizer_baset::summarize_in_workers(
+  const std::vector<function_namet> &functions)
+{
+#ifdef _WIN32
+  for(const auto &f : functions)
+  {
+    status() << "\nSummarizing function " << f << eom;
+    compute_summary_rec(f, true_exprt(), false);
+  }
+#else
+  std::size_t jobs=std::min<std::size_t>(
+    options.get_unsigned_int_option("jobs"), functions.size());
+
+  std::vector<std::vector<function_namet>> chunks(jobs);
+  for(std::size_t i=0; i<functions.size(); ++i)
+    chunks[i%jobs].push_back(functions[i]);
+
+  status() << "\nSummarizing " << functions.size() << " functions in "
+           << jobs << " worker processes" << eom;
+
+  std::vector<std::pair<pid_t, std::string>> workers;
+  for(const auto &chunk : chunks)
+  {
+    std::string file_name=get_temporary_file("2ls_summaries_", ".bin");
+    std::cout.flush();
+    pid_t pid=fork();
+    if(pid==0)
+    {
+      int exit_code=0;
+      try
+      {
+        unsigned solver_instances_before=solver_instances;
+        unsigned solver_calls_before=solver_calls;
+        unsigned summaries_used_before=summaries_used;
+        unsigned termargs_computed_before=termargs_computed;
+
+        irept result("summaries");
+        for(const auto &f : chunk)
+        {
+          status() << "\nSummarizing function " << f << eom;
+          compute_summary_rec(f, true_exprt(), false);
+
+          irept entry("entry");
+          entry.set(ID_name, f);
+          entry.set("summary", summary_db.get(f).to_irep());
+          result.get_sub().push_back(entry);
+        }
+        result.set(
+          "solver_instances", solver_instances-solver_instances_before);
+        result.set("solver_calls", solver_calls-solver_calls_before);
+        result.set("summaries_used", summaries_used-summaries_used_before);
+        result.set(
+          "termargs_computed", termargs_computed-termargs_computed_before);
+
+        std::ofstream out(file_name, std::ios::binary);
+        irep_serializationt::ireps_containert ireps_container;
+        irep_serializationt irep_serialization(ireps_container);
+        irep_serialization.reference_convert(result, out);
+        out.close();
+        if(!out)
+          exit_code=1;
+      }
+      catch(...)
+      {
+        exit_code=1;
+      }
+      std::cout.flush();
+      _exit(exit_code);
+    }
+    else if(pid<0)
+    {
+      // could not fork, summarize in this process
+      for(const auto &f : chunk)
+      {
+        status() << "\nSummarizing function " << f << eom;
+        compute_summary_rec(f, true_exprt(), false);
+      }
+      std::remove(file_name.c_str());
+    }
+    else
+      workers.push_back(std::make_pair(pid, file_name));
+  }
+
+  bool failed=false;
+  for(const auto &worker : workers)
+  {
+    int worker_status;
+    if(waitpid(worker.first, &worker_status, 0)!=worker.first ||
+       !WIFEXITED(worker_status) || WEXITSTATUS(worker_status)!=0)
+    {
+      failed=true;
+      std::remove(worker.second.c_str());
+      continue;
+    }
+
+    std::ifstream in(worker.second, std::ios::binary);
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    irept result=irep_serialization.reference_convert(in);
+    in.close();
+    std::remove(worker.second.c_str());
+
+    for(const auto &entry : result.get_sub())
+    {
+      const irep_idt &f=entry.get(ID_name);
+      summaryt summary;
+      summary.from_irep(entry.find("summary"));
+      summary.set_value_domains(ssa_db.get(f));
+      summary_db.put(f, std::move(summary));
+    }
+
+    solver_instances+=result.get_long_long("solver_instances");
+    solver_calls+=result.get_long_long("solver_calls");
+    summaries_used+=result.get_long_long("summaries_used");
+    termargs_computed+=result.get_long_long("termargs_computed");
+  }
+
+  if(failed)
+    throw "summarization worker process failed";
+#endif
+}
+
+/// Replaces the numbers in the identifiers of symbols that lie between the
+/// location numbers of the first and the last instruction of a function by
+/// their offset to the first one, written as {offset}, or reverts this.
+/// SSA names contain location numbers, which change for all functions that
+/// follow an edited one. With relative numbers, the names of a function do
+/// not depend on the other functions.
+static void relocate_identifiers(
+  irept &irep,
+  unsigned first,
+  unsigned last,
+  bool to_relative)
+{
+  if(irep.id()==ID_symbol || irep.id()==ID_nondet_symbol)
+  {
+    const std::string &id=id2string(irep.get(ID_identifier));
+    std::string new_id;
+    std::size_t i=0;
+    while(i<id.size())
+    {
+      if(to_relative && isdigit(static_cast<unsigned char>(id[i])))
+      {
+        std::size_t j=i;
+        while(j<id.size() && isdigit(static_cast<unsigned char>(id[j])))
+          j++;
+        const std::string digits=id.substr(i, j-i);
+        i=j;
+        if(digits.size()<=9)
+        {
+          unsigned number=std::stoul(digits);
+          if(number>=first && number<=last)
+          {
+            new_id+="{"+std::to_string(number-first)+"}";
+            continue;
+          }
+        }
+        new_id+=digits;
+      }
+      else if(!to_relative && id[i]=='{')
+      {
+        std::size_t j=i+1;
+        while(j<id.size() && isdigit(static_cast<unsigned char>(id[j])))
+          j++;
+        if(j>i+1 && j-i<=10 && j<id.size() && id[j]=='}')
+        {
+          new_id+=std::to_string(first+std::stoul(id.substr(i+1, j-i-1)));
+          i=j+1;
+        }
+        else
+          new_id+=id[i++];
+      }
+      else
+        new_id+=id[i++];
+    }
+    irep.set(ID_identifier, new_id);
+  }
+
+  for(auto &sub : irep.get_sub())
+    relocate_identifiers(sub, first, last, to_relative);
+  for(auto &named_sub : irep.get_named_sub())
+    relocate_identifiers(named_sub.second, first, last, to_relative);
+}
+
+static void remove_source_locations(irept &irep)
+{
+  irep.remove(ID_C_source_location);
+  for(auto &sub : irep.get_sub())
+    remove_source_locations(sub);
+  for(auto &named_sub : irep.get_named_sub())
+    remove_source_locations(named_sub.second);
+}
+
+/// Makes the location numbers in the identifiers of the summary relative to
+/// the first instruction of the function, or absolute again, see
+/// \ref relocate_identifiers. Summaries are stored in the summary cache with
+/// relative location numbers.
+void summarizer_baset::relocate_summary(
+  summaryt &summary,
+  const local_SSAt &SSA,
+  bool to_relative)
+{
+  const auto &instructions=SSA.goto_function.body.instructions;
+  if(instructions.empty())
+    return;
+  irept irep=summary.to_irep();
+  relocate_identifiers(
+    irep,
+    instructions.front().location_number,
+    instructions.back().location_number,
+    to_relative);
+  summary.from_irep(irep);
+}
+
+/// Computes the key of the summary of the given function in the summary
+/// cache. It is a hash of everything that the summary depends on: the SSA of
+/// the function (including the types of used symbols), the summaries of the
+/// callees, the calling context and the options affecting the analysis.
+/// Location numbers are made relative to the first instruction of the
+/// function and source locations are left out, hence the key does not change
+/// when other functions are edited.
+std::string summarizer_baset::summary_cache_key(
+  const function_namet &function_name,
+  const local_SSAt &SSA,
+  const exprt &precondition)
+{
+  std::ostringstream data;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_serialization(ireps_container);
+
+  const auto &instructions=SSA.goto_function.body.instructions;
+  unsigned first=
+    instructions.empty() ? 0 : instructions.front().location_number;
+  unsigned last=
+    instructions.empty() ? 0 : instructions.back().location_number;
+  auto convert=[&](const irept &irep, unsigned first, unsigned last)
+  {
+    irept relative=irep;
+    relocate_identifiers(relative, first, last, true);
+    remove_source_locations(relative);
+    irep_serialization.reference_convert(relative, data);
+  };
+
+  data << function_name << '\n';
+
+  // options that influence summaries
+  const char *option_names[]=
+  {
+    "intervals", "zones", "octagons", "qzones", "equalities", "heap",
+    "arrays", "sympath", "enum-solver", "binsearch-solver",
+    "binsearch-batch", "omt-solver", "reuse-invariants", "pack-size",
+    "std-invariants", "havoc", "refine", "context-sensitive",
+    "competition-mode", "goal-driven", "pointer-check",
+    "memory-leak-check", "signed-overflow-check",
+    "unsigned-overflow-check", "bounds-check", "div-by-zero-check"
+  };
+  for(const auto &option_name : option_names)
+    data << option_name << '=' << options.get_option(option_name) << '\n';
+
+  // SSA
+  find_symbols_sett symbols;
+  for(const auto &node : SSA.nodes)
+  {
+    data << "node\n";
+    for(const auto &e : node.equalities)
+    {
+      convert(e, first, last);
+      find_type_and_expr_symbols(e, symbols);
+    }
+    data << "constraints\n";
+    for(const auto &c : node.constraints)
+    {
+      convert(c, first, last);
+      find_type_and_expr_symbols(c, symbols);
+    }
+    data << "assertions\n";
+    for(const auto &a : node.assertions)
+      convert(a, first, last);
+    data << "calls\n";
+    for(const auto &f : node.function_calls)
+    {
+      convert(f, first, last);
+      find_type_and_expr_symbols(f, symbols);
+    }
+    data << "templates\n";
+    for(const auto &t : node.templates)
+      convert(t, first, last);
+    convert(node.enabling_expr, first, last);
+    if(node.loophead!=SSA.nodes.end())
+    {
+      data << "loop "
+           << node.loophead->location->location_number-first << '\n';
+    }
+  }
+  convert(SSA.get_enabling_exprs(), first, last);
+  for(const auto &param : SSA.params)
+    convert(param, first, last);
+  for(const auto &global : SSA.globals_in)
+    convert(global, first, last);
+  for(const auto &global : SSA.globals_out)
+    convert(global, first, last);
+
+  // definitions of used types (sorted by name to get a stable order)
+  std::set<std::string> symbol_names;
+  for(const auto &symbol : symbols)
+    symbol_names.insert(id2string(symbol));
+  for(const auto &symbol_name : symbol_names)
+  {
+    const symbolt *symbol;
+    if(!SSA.ns.lookup(symbol_name, symbol) && symbol->is_type)
+      convert(symbol->type, first, last);
+  }
+
+  // calling context
+  convert(precondition, first, last);
+
+  // callee summaries
+  for(const auto &node : SSA.nodes)
+  {
+    for(const auto &call : node.function_calls)
+    {
+      if(call.function().id()!=ID_symbol)
+        continue;
+      irep_idt fname=to_symbol_expr(call.function()).get_identifier();
+      data << "callee " << fname << '\n';
+      if(!summary_db.exists(fname))
+        continue;
+      // the summary is over the SSA names of the callee
+      unsigned callee_first=0, callee_last=0;
+      if(ssa_db.exists(fname))
+      {
+        const auto &callee_instructions=
+          ssa_db.get(fname).goto_function.body.instructions;
+        if(!callee_instructions.empty())
+        {
+          callee_first=callee_instructions.front().location_number;
+          callee_last=callee_instructions.back().location_number;
+        }
+      }
+      convert(summary_db.get(fname).to_irep(), callee_first, callee_last);
+    }
+  }
+
+  // 64-bit FNV-1a hash
+  const std::string &bytes=data.str();
+  uint64_t hash=14695981039346656037ULL;
+  for(const auto c : bytes)
+  {
+    hash^=static_cast<unsigned char>(c);
+    hash*=1099511628211ULL;
+  }
+
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash
+      << '-' << std::setw(8) << bytes.size();
+  return key.str();
+}
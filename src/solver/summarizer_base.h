@@ -12,6 +12,9 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_SOLVER_SUMMARIZER_BASE_H
 #define CPROVER_2LS_SOLVER_SUMMARIZER_BASE_H
 
+#include <set>
+#include <vector>
+
 #include <util/message.h>
 #include <util/options.h>
 
@@ -50,6 +53,9 @@ public:
 
   virtual void summarize();
   virtual void summarize(const function_namet &entry_function);
+  void summarize_goals(
+    const function_namet &entry_function,
+    const std::set<function_namet> &goals);
 
   unsigned get_number_of_solver_instances() { return solver_instances; }
   unsigned get_number_of_solver_calls() { return solver_calls; }
@@ -104,6 +110,43 @@ public:
     local_SSAt &SSA,
     const exprt &cond);
 
+  // key of the function summary in the persistent summary cache
+  std::string summary_cache_key(
+    const function_namet &function_name,
+    const local_SSAt &SSA,
+    const exprt &precondition);
+  // cached summaries have location numbers relative to the function
+  void relocate_summary(
+    summaryt &summary,
+    const local_SSAt &SSA,
+    bool to_relative);
+
+  // bottom-up scheduling of the summary computation along the call graph
+  typedef std::set<function_namet> function_sett;
+  typedef std::vector<function_sett> call_graph_levelst;
+
+  bool summarize_bottom_up_enabled() const;
+  void summarize_bottom_up(const function_sett &functions);
+  void get_callees(const function_namet &function_name, function_sett &callees);
+  void collect_reachable_functions(
+    const function_namet &entry_function,
+    function_sett &functions);
+  void compute_call_graph_levels(
+    const function_sett &functions,
+    call_graph_levelst &levels,
+    function_sett &cyclic);
+  void summarize_in_workers(const std::vector<function_namet> &functions);
+
+  // demand-driven summarization of the functions relevant to the properties,
+  // empty if all functions are relevant
+  function_sett relevant_functions;
+  void collect_relevant_functions(
+    const function_sett &goals,
+    function_sett &functions);
+  bool may_change_calling_context(
+    const function_namet &function_name,
+    const std::set<irep_idt> &globals_read);
+
   // statistics
   unsigned solver_instances;
   unsigned solver_calls;
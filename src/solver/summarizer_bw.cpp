@@ -27,6 +27,7 @@ Author: Peter Schrammel
 
 #include <ssa/local_ssa.h>
 #include <ssa/simplify_ssa.h>
+#include <ssa/profiler.h>
 
 #include "summarizer_bw.h"
 #include "summary_db.h"
@@ -84,6 +85,7 @@ void summarizer_bwt::compute_summary_rec(
     options.get_bool_option("sufficient"));
 
   status() << "Analyzing function "  << function_name << eom;
+  profilert::scoped_timert timer("summarization", function_name);
 
   // create summary
   summaryt summary;
@@ -24,6 +24,7 @@ Author: Peter Schrammel
 
 #include <ssa/local_ssa.h>
 #include <ssa/simplify_ssa.h>
+#include <ssa/profiler.h>
 
 #include "summarizer_bw_term.h"
 #include "summarizer_fw_term.h"
@@ -46,6 +47,7 @@ void summarizer_bw_termt::compute_summary_rec(
     function_name, SSA, old_summary, postcondition, context_sensitive, false);
 
   status() << "Analyzing function "  << function_name << eom;
+  profilert::scoped_timert timer("summarization", function_name);
 
   bool has_loops=false;
   for(local_SSAt::nodest::iterator n_it=SSA.nodes.begin();
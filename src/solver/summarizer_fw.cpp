@@ -22,6 +22,8 @@ Author: Peter Schrammel
 #include <domains/ssa_analyzer.h>
 #include <domains/template_generator_summary.h>
 
+#include <ssa/profiler.h>
+
 // #define SHOW_WHOLE_RESULT
 
 void summarizer_fwt::compute_summary_rec(
@@ -34,7 +36,28 @@ void summarizer_fwt::compute_summary_rec(
   // recursively compute summaries for function calls
   inline_summaries(function_name, SSA, precondition, context_sensitive);
 
+  std::string cache_key;
+  if(summary_db.cache_enabled())
+  {
+    cache_key=summary_cache_key(function_name, SSA, precondition);
+
+    // cached summaries do not contain the abstract value, from which
+    // --reuse-invariants starts at the next unwinding
+    summaryt summary;
+    if(!options.get_bool_option("reuse-invariants") &&
+       summary_db.read_cached(cache_key, function_name, summary))
+    {
+      relocate_summary(summary, SSA, false);
+      status() << "Using cached summary for function " << function_name
+               << eom;
+      summary.set_value_domains(SSA);
+      summary_db.put(function_name, std::move(summary));
+      return;
+    }
+  }
+
   status() << "Analyzing function "  << function_name << eom;
+  profilert::scoped_timert timer("summarization", function_name);
 
 #if 0
   {
@@ -76,6 +99,14 @@ void summarizer_fwt::compute_summary_rec(
   }
 #endif
 
+  if(summary_db.cache_enabled())
+  {
+    summaryt cached_summary;
+    cached_summary.from_irep(summary.to_irep());
+    relocate_summary(cached_summary, SSA, true);
+    summary_db.write_cached(cache_key, function_name, cached_summary);
+  }
+
   // store summary in db
   summary_db.put(function_name, std::move(summary));
 
@@ -116,24 +147,16 @@ void summarizer_fwt::do_summary(
   conds.push_back(summary.fw_precondition);
   conds.push_back(ssa_inliner.get_summaries(SSA));
 
-#ifdef REUSE_INVARIANTS
-  if(summary_db.exists(function_name)) // reuse existing invariants
-  {
-    const exprt &old_inv=summary_db.get(function_name).fw_invariant;
-    exprt inv=ssa_unwinder->get(function_name).rename_invariant(old_inv);
-    conds.push_back(inv);
+  cond=conjunction(conds);
 
-#if 0
-    std::ostringstream out;
-    out << "(original inv)" << from_expr(SSA.ns, "", old_inv) << "\n";
-    debug() << out.str() << eom;
-    out << "(renamed inv)" << from_expr(SSA.ns, "", inv) << "\n";
-    debug() << out.str() << eom;
-#endif
+  // start from the abstract value computed for the previous unwinding
+  if(options.get_bool_option("reuse-invariants") &&
+     summary_db.exists(function_name))
+  {
+    const summaryt &old_summary=summary_db.get(function_name);
+    if(old_summary.fw_domain_ptr && old_summary.fw_value_ptr)
+      analyzer.set_seed(*old_summary.fw_domain_ptr, *old_summary.fw_value_ptr);
   }
-#endif
-
-  cond=conjunction(conds);
 
   analyzer(solver, SSA, cond, template_generator);
   analyzer.get_result(summary.fw_transformer, template_generator.inout_vars());
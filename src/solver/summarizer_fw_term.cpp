@@ -24,6 +24,7 @@ Author: Peter Schrammel
 
 #include <ssa/local_ssa.h>
 #include <ssa/simplify_ssa.h>
+#include <ssa/profiler.h>
 
 #include "summarizer_fw_term.h"
 #include "summary_db.h"
@@ -54,6 +55,7 @@ void summarizer_fw_termt::compute_summary_rec(
     has_function_calls);
 
   status() << "Analyzing function "  << function_name << eom;
+  profilert::scoped_timert timer("summarization", function_name);
 
   {
     std::ostringstream out;
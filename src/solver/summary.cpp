@@ -13,7 +13,13 @@ Author: Peter Schrammel
 #include <langapi/language_util.h>
 #endif
 
+#include <map>
+#include <unordered_set>
+
+#include <util/arith_tools.h>
+
 #include <domains/util.h>
+#include <domains/solver_pool.h>
 
 #include "summary.h"
 
@@ -126,6 +132,153 @@ void summaryt::join(const summaryt &new_summary)
   }
 }
 
+/// Simplifies the over-approximating summary components that accumulate
+/// conjunctions of summaries of different calling contexts.
+void summaryt::simplify(const namespacet &ns, unsigned max_conjuncts)
+{
+  simplify_conjunction(fw_transformer, ns, max_conjuncts);
+  simplify_conjunction(fw_invariant, ns, max_conjuncts);
+}
+
+/// Up to this number of conjuncts, subsumed conjuncts are searched for
+/// using a solver.
+#define MAX_SUBSUMPTION_CONJUNCTS 64
+
+static void collect_conjuncts(const exprt &expr, exprt::operandst &conjuncts)
+{
+  if(expr.id()==ID_and)
+  {
+    for(const auto &op : expr.operands())
+      collect_conjuncts(op, conjuncts);
+  }
+  else
+    conjuncts.push_back(expr);
+}
+
+/// \return the number of conjuncts of the flattened conjunction
+std::size_t summaryt::count_conjuncts(const exprt &expr)
+{
+  exprt::operandst conjuncts;
+  collect_conjuncts(expr, conjuncts);
+  return conjuncts.size();
+}
+
+/// Decomposes a template row constraint of the form
+/// [premise ==>] lhs<=bound with a constant integer bound.
+/// \return false if the expression is not of that form
+static bool split_template_row(
+  const exprt &expr,
+  exprt &premise,
+  exprt &lhs,
+  mp_integer &bound)
+{
+  const exprt *row=&expr;
+  premise=true_exprt();
+  if(expr.id()==ID_implies)
+  {
+    premise=to_implies_expr(expr).op0();
+    row=&to_implies_expr(expr).op1();
+  }
+  if(row->id()!=ID_le)
+    return false;
+  const binary_relation_exprt &le=to_binary_relation_expr(*row);
+  if(le.op1().id()!=ID_constant ||
+     to_integer(to_constant_expr(le.op1()), bound))
+    return false;
+  lhs=le.op0();
+  return true;
+}
+
+/// Simplifies a conjunction that over-approximates the behaviour of a
+/// function: nested conjunctions are flattened, duplicate and trivially
+/// true conjuncts are removed, template rows that bound the same term under
+/// the same premise are merged into the tightest one, and conjuncts that
+/// are implied by the remaining ones are removed. Finally, the first
+/// max_conjuncts conjuncts are kept (0 means no limit), which weakens the
+/// summary but keeps it sound.
+void summaryt::simplify_conjunction(
+  exprt &expr,
+  const namespacet &ns,
+  unsigned max_conjuncts)
+{
+  if(expr.id()!=ID_and)
+    return;
+
+  exprt::operandst conjuncts;
+  collect_conjuncts(expr, conjuncts);
+
+  // remove duplicates and merge template rows
+  exprt::operandst simplified;
+  std::unordered_set<exprt, irep_hash> seen;
+  std::map<std::pair<exprt, exprt>, std::size_t> rows;
+  for(const auto &conjunct : conjuncts)
+  {
+    if(conjunct.is_true())
+      continue;
+    if(conjunct.is_false())
+    {
+      expr=false_exprt();
+      return;
+    }
+    if(!seen.insert(conjunct).second)
+      continue;
+
+    exprt premise, lhs;
+    mp_integer bound;
+    if(split_template_row(conjunct, premise, lhs, bound))
+    {
+      auto row=rows.insert(
+        std::make_pair(std::make_pair(premise, lhs), simplified.size()));
+      if(!row.second)
+      {
+        exprt &existing=simplified[row.first->second];
+        exprt existing_premise, existing_lhs;
+        mp_integer existing_bound;
+        split_template_row(
+          existing, existing_premise, existing_lhs, existing_bound);
+        if(bound<existing_bound)
+          existing=conjunct;
+        continue;
+      }
+    }
+    simplified.push_back(conjunct);
+  }
+
+  // remove conjuncts that are implied by the others
+  if(simplified.size()>1 && simplified.size()<=MAX_SUBSUMPTION_CONJUNCTS)
+  {
+    incremental_solvert *solver=
+      solver_poolt::get().acquire(ns, null_message_handler);
+    std::vector<bool> removed(simplified.size(), false);
+    for(std::size_t i=simplified.size(); i-->0;)
+    {
+      solver->new_context();
+      for(std::size_t j=0; j<simplified.size(); ++j)
+      {
+        if(j!=i && !removed[j])
+          *solver << simplified[j];
+      }
+      *solver << not_exprt(simplified[i]);
+      removed[i]=(*solver)()==decision_proceduret::resultt::D_UNSATISFIABLE;
+      solver->pop_context();
+    }
+    solver_poolt::get().release(solver);
+
+    exprt::operandst kept;
+    for(std::size_t i=0; i<simplified.size(); ++i)
+    {
+      if(!removed[i])
+        kept.push_back(simplified[i]);
+    }
+    simplified.swap(kept);
+  }
+
+  if(max_conjuncts>0 && simplified.size()>max_conjuncts)
+    simplified.resize(max_conjuncts);
+
+  expr=conjunction(simplified);
+}
+
 /// Get value domain for last location from SSA.
 void summaryt::set_value_domains(const local_SSAt &SSA)
 {
@@ -135,6 +288,60 @@ void summaryt::set_value_domains(const local_SSAt &SSA)
   value_domain_out=SSA.ssa_value_ai[exit_loc];
 }
 
+irept summaryt::to_irep() const
+{
+  irept irep("summary");
+
+  irept &params_irep=irep.add("params");
+  for(const auto &param : params)
+    params_irep.get_sub().push_back(param);
+  irept &globals_in_irep=irep.add("globals_in");
+  for(const auto &global : globals_in)
+    globals_in_irep.get_sub().push_back(global);
+  irept &globals_out_irep=irep.add("globals_out");
+  for(const auto &global : globals_out)
+    globals_out_irep.get_sub().push_back(global);
+
+  irep.set("fw_precondition", fw_precondition);
+  irep.set("fw_transformer", fw_transformer);
+  irep.set("fw_invariant", fw_invariant);
+  irep.set("bw_precondition", bw_precondition);
+  irep.set("bw_postcondition", bw_postcondition);
+  irep.set("bw_transformer", bw_transformer);
+  irep.set("bw_invariant", bw_invariant);
+  irep.set("aux_precondition", aux_precondition);
+  irep.set("termination_argument", termination_argument);
+  irep.set("terminates", static_cast<long long>(terminates));
+
+  return irep;
+}
+
+void summaryt::from_irep(const irept &irep)
+{
+  params.clear();
+  for(const auto &param : irep.find("params").get_sub())
+    params.push_back(to_symbol_expr(static_cast<const exprt &>(param)));
+  globals_in.clear();
+  for(const auto &global : irep.find("globals_in").get_sub())
+    globals_in.insert(to_symbol_expr(static_cast<const exprt &>(global)));
+  globals_out.clear();
+  for(const auto &global : irep.find("globals_out").get_sub())
+    globals_out.insert(to_symbol_expr(static_cast<const exprt &>(global)));
+
+  fw_precondition=static_cast<const exprt &>(irep.find("fw_precondition"));
+  fw_transformer=static_cast<const exprt &>(irep.find("fw_transformer"));
+  fw_invariant=static_cast<const exprt &>(irep.find("fw_invariant"));
+  bw_precondition=static_cast<const exprt &>(irep.find("bw_precondition"));
+  bw_postcondition=static_cast<const exprt &>(irep.find("bw_postcondition"));
+  bw_transformer=static_cast<const exprt &>(irep.find("bw_transformer"));
+  bw_invariant=static_cast<const exprt &>(irep.find("bw_invariant"));
+  aux_precondition=static_cast<const exprt &>(irep.find("aux_precondition"));
+  termination_argument=
+    static_cast<const exprt &>(irep.find("termination_argument"));
+  terminates=static_cast<threevalt>(irep.get_long_long("terminates"));
+  mark_recompute=false;
+}
+
 std::string threeval2string(threevalt v)
 {
   switch(v)
@@ -74,9 +74,21 @@ class summaryt
   void output(std::ostream &out, const namespacet &ns) const;
 
   void join(const summaryt &new_summary);
+  void simplify(const namespacet &ns, unsigned max_conjuncts);
+
+  static void simplify_conjunction(
+    exprt &expr,
+    const namespacet &ns,
+    unsigned max_conjuncts);
+  static std::size_t count_conjuncts(const exprt &expr);
 
   void set_value_domains(const local_SSAt &SSA);
 
+  // conversion from/to irep for storing summaries outside the process
+  // (abstract domains, abstract values and value domains are not stored)
+  irept to_irep() const;
+  void from_irep(const irept &irep);
+
  protected:
   void combine_or(exprt &olde, const exprt &newe);
   void combine_and(exprt &olde, const exprt &newe);
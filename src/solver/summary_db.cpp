@@ -10,8 +10,15 @@ Author: Daniel Kroening, kroening@kroening.com
 /// Storage for Function Summaries
 
 #include <fstream>
+#include <cstdio>
 
-#include <json/json_parser.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <util/irep_serialization.h>
 
 #include "summary_db.h"
 
@@ -23,7 +30,20 @@ void summary_dbt::put(
      store[function_name].mark_recompute)
     store[function_name]=std::move(summary);
   else
-    store[function_name].join(summary);
+  {
+    summaryt &joined=store[function_name];
+    joined.join(summary);
+    if(ns)
+    {
+      std::size_t conjuncts=
+        summaryt::count_conjuncts(joined.fw_transformer);
+      joined.simplify(*ns, max_conjuncts);
+      debug() << "Simplified the forward transformer of " << function_name
+              << " from " << conjuncts << " to "
+              << summaryt::count_conjuncts(joined.fw_transformer)
+              << " conjuncts" << eom;
+    }
+  }
 }
 
 void summary_dbt::mark_recompute_all()
@@ -33,22 +53,80 @@ void summary_dbt::mark_recompute_all()
     it->second.mark_recompute=true;
 }
 
-std::string summary_dbt::file_name(const std::string &id)
+void summary_dbt::mark_recompute(const function_namet &function_name)
 {
-  return "summary."+id;
+  std::map<function_namet, summaryt>::iterator it=store.find(function_name);
+  if(it!=store.end())
+    it->second.mark_recompute=true;
 }
 
-void summary_dbt::read(const std::string &id)
+std::string summary_dbt::file_name(const std::string &key)
 {
-  current=id;
+  return cache_directory+"/"+key+".summary";
+}
 
-  summary.make_object();
+#define SUMMARY_CACHE_HEADER "2LS summary 2"
+
+/// reads the summary stored under the given key
+/// \return true if the summary has been found
+bool summary_dbt::read_cached(
+  const std::string &key,
+  const function_namet &function_name,
+  summaryt &summary)
+{
+  std::ifstream in(file_name(key).c_str(), std::ios::binary);
+  if(!in)
+    return false;
 
-  parse_json(file_name(id), get_message_handler(), summary);
+  std::string header;
+  std::getline(in, header);
+  if(header!=SUMMARY_CACHE_HEADER)
+    return false;
+
+  try
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    const irept &irep=irep_serialization.reference_convert(in);
+    if(!in || irep.get(ID_name)!=function_name)
+      return false;
+    summary.from_irep(irep.find("summary"));
+  }
+  catch(...)
+  {
+    warning() << "Ignoring corrupted summary cache entry "
+              << file_name(key) << eom;
+    return false;
+  }
+
+  return true;
 }
 
-void summary_dbt::write()
+/// stores the summary under the given key
+void summary_dbt::write_cached(
+  const std::string &key,
+  const function_namet &function_name,
+  const summaryt &summary)
 {
-  std::ofstream out(file_name(current).c_str());
-  out << summary << '\n';
+  // write to a temporary file first to make concurrent runs safe
+  std::string tmp_file_name=file_name(key)+".tmp"+std::to_string(getpid());
+  {
+    std::ofstream out(tmp_file_name.c_str(), std::ios::binary);
+    if(!out)
+    {
+      warning() << "Cannot write summary cache entry "
+                << file_name(key) << eom;
+      return;
+    }
+
+    irept irep("cached_summary");
+    irep.set(ID_name, function_name);
+    irep.set("summary", summary.to_irep());
+
+    out << SUMMARY_CACHE_HEADER << '\n';
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    irep_serialization.reference_convert(irep, out);
+  }
+  std::rename(tmp_file_name.c_str(), file_name(key).c_str());
 }
@@ -12,18 +12,17 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_2LS_SOLVER_SUMMARY_DB_H
 #define CPROVER_2LS_SOLVER_SUMMARY_DB_H
 
+#include <memory>
+
 #include "summary.h"
 #include <util/message.h>
-#include <util/json.h>
+#include <util/make_unique.h>
 
 class summary_dbt:public messaget
 {
 public:
   typedef irep_idt function_namet;
 
-  // retrieve a summary for function with given identifier
-  void read(const std::string &);
-  void write();
   void clear() { store.clear(); }
 
   const summaryt &get(const function_namet &function_name) const
@@ -33,14 +32,38 @@ public:
   void put(const function_namet &function_name, summaryt &&summary);
 
   void mark_recompute_all();
+  void mark_recompute(const function_namet &function_name);
+
+  // simplification of summaries joined from several calling contexts
+  void set_join_simplification(
+    const symbol_tablet &symbol_table,
+    unsigned _max_conjuncts)
+  {
+    ns=util_make_unique<namespacet>(symbol_table);
+    max_conjuncts=_max_conjuncts;
+  }
 
-  jsont summary;
+  // persistent cache of summaries indexed by a content hash of the function
+  void set_cache_directory(const std::string &directory)
+    { cache_directory=directory; }
+  bool cache_enabled() const { return !cache_directory.empty(); }
+  bool read_cached(
+    const std::string &key,
+    const function_namet &function_name,
+    summaryt &summary);
+  void write_cached(
+    const std::string &key,
+    const function_namet &function_name,
+    const summaryt &summary);
 
 protected:
   std::map<function_namet, summaryt> store;
 
-  std::string current;
-  std::string file_name(const std::string &);
+  std::unique_ptr<namespacet> ns;
+  unsigned max_conjuncts=0;
+
+  std::string cache_directory;
+  std::string file_name(const std::string &key);
 };
 
 #endif
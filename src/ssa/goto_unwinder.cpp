@@ -314,9 +314,29 @@ void goto_local_unwindert::recompute_ssa()
   if(simplify)
     ::simplify(SSA, SSA.ns);
   update_ssa(SSA, goto_function.body);
-  // Also clear the solver, there may be left-overs with different indices
-  // FIXME: This defeats the purpose of incremental solving
-  ssa_db.clear_solver(function_name);
+  // The solver may contain left-overs of the previous SSA version with
+  // different indices, these get disabled by the new enabling literal.
+  enable_ssa_version(SSA);
+}
+
+/// Guards all nodes of the current SSA version of the function by a fresh
+/// enabling literal. The enabling expressions of the SSA enable this version
+/// and disable all the previous ones, hence the constraints already pushed
+/// into the incremental solver of the function become vacuous and the solver
+/// can be reused.
+void goto_local_unwindert::enable_ssa_version(local_SSAt &SSA)
+{
+  symbol_exprt enabling_expr(
+    "goto_unwind::"+id2string(function_name)+"::enable"+
+      std::to_string(current_unwinding),
+    bool_typet());
+  enabling_exprs.push_back(enabling_expr);
+  debug() << "Enabling SSA version " << enabling_exprs.size() << " of "
+          << function_name << messaget::eom;
+
+  SSA.enabling_exprs=enabling_exprs;
+  for(auto &node : SSA.nodes)
+    node.enabling_expr=enabling_expr;
 }
 
 /// Converts assertions in an SSA node to constraints in BMC and k-induction
@@ -476,6 +496,11 @@ void goto_local_unwindert::update_ssa(
 void goto_local_unwindert::init()
 {
   current_unwinding=0;
+  enabling_exprs.clear();
+  // The initial SSA must be guarded as well as it is replaced when unwinding
+  if(ssa_db.exists(function_name) &&
+     !has_prefix(id2string(function_name), TEMPLATE_DECL))
+    enable_ssa_version(ssa_db.get(function_name));
 }
 
 /// No-op, the continuation of loops is not special in any way in this unwinder,
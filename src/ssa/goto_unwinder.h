@@ -10,9 +10,12 @@ Author: František Nečas
 /// loops which create dynamic objects (points-to analysis
 /// is kept in sync with the actual state of dynamic objects).
 ///
-/// The current implementation doesn't utilise incremental SAT solving
-/// correctly so its performance is hindered, however it produces more
-/// sound results in the case of programs with dynamic memory.
+/// Since the SSA is recomputed after each unwinding, the constraints of
+/// each SSA version are guarded by a fresh enabling literal. This allows
+/// to keep the incremental solver of the function (and its learnt clauses)
+/// across unwindings by disabling the constraints of the old versions.
+/// The unwinder produces more sound results in the case of programs with
+/// dynamic memory.
 /// Moreover due to the current implementation of summary_checker_nonterm,
 /// (relying on renames based on % suffixes), nontermination support
 /// is not possible in this type of implementation.
@@ -55,6 +58,9 @@ public:
     const local_SSAt::nodet &node,
     bool pre) const override;
 
+  // the SSA is rebuilt after renumbering the locations of all functions
+  bool is_unwinding_dependent() const override { return true; }
+
 protected:
   /// A flag which is used for marking unwind starts inside the GOTO program.
   const irep_idt unwind_flag="unwind";
@@ -77,6 +83,9 @@ protected:
   /// before transformations required for k-induction or BMC to correctly
   /// work were done.
   std::map<goto_programt::targett, goto_programt::targett> loop_targets;
+  /// Enabling literals of all SSA versions of the function created so far,
+  /// the last one belongs to the current version.
+  std::list<symbol_exprt> enabling_exprs;
 
   void unwind_function(unsigned to_unwind);
   void mark_unwinds(
@@ -92,6 +101,7 @@ protected:
   void reconnect_loops();
   void reset_loop_connections();
   void recompute_ssa();
+  void enable_ssa_version(local_SSAt &SSA);
   void update_ssa(
     local_SSAt &SSA,
     const goto_programt &goto_program);
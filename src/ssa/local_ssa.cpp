@@ -30,12 +30,17 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ssa_dereference.h"
 #include "address_canonizer.h"
 #include "dynamic_objects.h"
+#include "profiler.h"
 
 void local_SSAt::build_SSA()
 {
+  profilert::scoped_timert timer("ssa_construction", function_identifier);
+
   // perform SSA data-flow analysis
   ssa_analysis(function_identifier, goto_function, ns);
 
+  node_index.map.clear();
+  node_index.valid=true;
   forall_goto_program_instructions(i_it, goto_function.body)
   {
     nodest::iterator loophead_node=nodes.end();
@@ -44,6 +49,7 @@ void local_SSAt::build_SSA()
       loophead_node=find_node(i_it->get_target());
     }
     nodes.push_back(nodet(i_it, loophead_node));
+    node_index.map[i_it->location_number].push_back(--nodes.end());
 
     build_transfer(i_it);
     build_phi_nodes(i_it);
@@ -176,38 +182,52 @@ void local_SSAt::collect_custom_templates()
   }
 }
 
+/// Builds the index of nodes by location number. Lists of nodes never
+/// invalidate iterators on insertion at the end, hence build_SSA extends the
+/// index incrementally. Transformations that erase nodes or insert them in
+/// the middle of the list (unwinding, inlining) invalidate the index.
+void local_SSAt::index_nodes() const
+{
+  node_index.map.clear();
+  nodest &all_nodes=const_cast<nodest &>(nodes);
+  for(nodest::iterator n_it=all_nodes.begin(); n_it!=all_nodes.end(); n_it++)
+    node_index.map[n_it->location->location_number].push_back(n_it);
+  node_index.valid=true;
+}
+
 local_SSAt::nodest::iterator local_SSAt::find_node(locationt loc)
 {
-  nodest::iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
-  {
-    if(n_it->location==loc)
-      break;
-  }
-  return n_it;
+  if(!node_index.valid)
+    index_nodes();
+  node_indext::mapt::const_iterator it=
+    node_index.map.find(loc->location_number);
+  if(it==node_index.map.end())
+    return nodes.end();
+  return it->second.front();
 }
 
 local_SSAt::nodest::const_iterator local_SSAt::find_node(locationt loc) const
 {
-  nodest::const_iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
-  {
-    if(n_it->location==loc)
-      break;
-  }
-  return n_it;
+  if(!node_index.valid)
+    index_nodes();
+  node_indext::mapt::const_iterator it=
+    node_index.map.find(loc->location_number);
+  if(it==node_index.map.end())
+    return nodes.end();
+  return it->second.front();
 }
 
 void local_SSAt::find_nodes(
   locationt loc,
   std::list<nodest::const_iterator> &_nodes) const
 {
-  nodest::const_iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
-  {
-    if(n_it->location==loc)
-      _nodes.push_back(n_it);
-  }
+  if(!node_index.valid)
+    index_nodes();
+  node_indext::mapt::const_iterator it=
+    node_index.map.find(loc->location_number);
+  if(it==node_index.map.end())
+    return;
+  _nodes.insert(_nodes.end(), it->second.begin(), it->second.end());
 }
 
 exprt local_SSAt::edge_guard(locationt from, locationt to) const
@@ -641,17 +661,16 @@ symbol_exprt local_SSAt::read_rhs(
   const irep_idt &identifier=object.get_identifier();
   const ssa_domaint &ssa_domain=ssa_analysis[loc];
 
-  ssa_domaint::def_mapt::const_iterator d_it=
-    ssa_domain.def_map.find(identifier);
+  const auto def=ssa_domain.def_map.find(identifier);
 
-  if(d_it==ssa_domain.def_map.end())
+  if(!def.has_value())
   {
     // not written so far, it's input
 
     return name_input(object);
   }
   else
-    return name(object, d_it->second.def);
+    return name(object, def->get());
 }
 
 exprt local_SSAt::read_lhs(
@@ -696,10 +715,7 @@ exprt local_SSAt::read_node_in(
   const irep_idt &identifier=object.get_identifier();
   const ssa_domaint &ssa_domain=ssa_analysis[loc];
 
-  ssa_domaint::def_mapt::const_iterator d_it=
-    ssa_domain.def_map.find(identifier);
-
-  if(d_it==ssa_domain.def_map.end())
+  if(!ssa_domain.def_map.has_key(identifier))
     return name_input(object); // not written so far
 
   const ssa_domaint::phi_nodest &phi_nodes=ssa_analysis[loc].phi_nodes;
@@ -739,13 +755,12 @@ local_SSAt::locationt local_SSAt::get_def_loc(
     const irep_idt &identifier=object.get_identifier();
     const ssa_domaint &ssa_domain=ssa_analysis[loc];
 
-    ssa_domaint::def_mapt::const_iterator d_it=
-      ssa_domain.def_map.find(identifier);
+    const auto def=ssa_domain.def_map.find(identifier);
 
-    if(d_it==ssa_domain.def_map.end()) // input
+    if(!def.has_value()) // input
       return goto_function.body.instructions.begin();
     else
-      return d_it->second.def.loc; // last definition
+      return def->get().loc; // last definition
   }
   else // input
     return goto_function.body.instructions.begin();
@@ -891,8 +906,8 @@ exprt local_SSAt::read_rhs_rec(const exprt &expr, locationt loc) const
     // the last definition may also be a PHI node at the end of malloc (
     // which covers the case-split whether malloc can fail).
     // Otherwise we need to use the last definition before the allocation.
-    auto def_it=ssa_analysis[loc].def_map.find(object.get_identifier());
-    auto maybe_alloc_def=get_recent_object_alloc_def(loc, def_it);
+    auto maybe_alloc_def=
+      get_recent_object_alloc_def(loc, object.get_identifier());
     if(maybe_alloc_def.has_value())
     {
       return if_exprt(
@@ -913,21 +928,22 @@ exprt local_SSAt::read_rhs_rec(const exprt &expr, locationt loc) const
 /// if so, return the allocation def. Otherwise returns nullopt.
 optionalt<ssa_domaint::deft> local_SSAt::get_recent_object_alloc_def(
   locationt loc,
-  const ssa_domaint::def_mapt::const_iterator &def) const
+  const irep_idt &identifier) const
 {
-  if(def==ssa_analysis[loc].def_map.end())
+  const auto maybe_def=ssa_analysis[loc].def_map.find(identifier);
+  if(!maybe_def.has_value())
     return nullopt;
 
-  if(def->second.def.is_allocation())
-    return def->second.def;
+  const ssa_domaint::deft &def=maybe_def->get();
+  if(def.is_allocation())
+    return def;
 
   // Not a direct allocation, follow the split if it is a phi node and add
   // guard if at least one of the branches is an allocation.
-  if(def->second.def.is_phi())
+  if(def.is_phi())
   {
-    const auto &phi_branches=
-      ssa_analysis[def->second.def.loc].phi_nodes.find(def->first);
-    if(phi_branches!=ssa_analysis[def->second.def.loc].phi_nodes.end())
+    const auto &phi_branches=ssa_analysis[def.loc].phi_nodes.find(identifier);
+    if(phi_branches!=ssa_analysis[def.loc].phi_nodes.end())
       for(const auto &phi_branch : phi_branches->second)
         if(phi_branch.second.is_allocation())
           return phi_branch.second;
@@ -1431,8 +1447,8 @@ bool local_SSAt::all_symbolic_deref_defined(
   if(ssa_object && has_symbolic_deref(ssa_object.get_expr()))
   {
     const ssa_domaint &ssa_domain=ssa_analysis[loc];
-    auto def_it=ssa_domain.def_map.find(ssa_object.get_identifier());
-    if(def_it==ssa_domain.def_map.end() || def_it->second.def.is_input())
+    const auto def=ssa_domain.def_map.find(ssa_object.get_identifier());
+    if(!def.has_value() || def->get().is_input())
       result=false;
   }
   else forall_operands(it, expr)
@@ -1515,11 +1531,11 @@ bool local_SSAt::can_reuse_symderef(
   // Get the last definition of the pointer
   const auto pointer_id=ssa_objectt(pointer, ns).get_identifier();
   const auto pointer_def=ssa_analysis[loc].def_map.find(
-    pointer_id)->second.def;
+    pointer_id)->get();
   // Get the last definition of the symbolic dereference
   const auto symbolic_id=symderef.get_identifier();
   const auto symbolic_def=ssa_analysis[loc].def_map.find(
-    symbolic_id)->second.def;
+    symbolic_id)->get();
 
   // If symbolic deref was not created yet, it cannot be reused.
   if(!symbolic_def.is_assignment())
@@ -1551,10 +1567,10 @@ bool local_SSAt::can_reuse_symderef(
     // If some potentially aliased object (or field) was overwritten,
     // the symbolic dereference cannot be reused.
     auto deref_def=ssa_analysis[loc].def_map.find(deref_id);
-    if(deref_def!=ssa_analysis[loc].def_map.end() &&
-       (deref_def->second.def.is_assignment() ||
-        deref_def->second.def.is_phi()) &&
-       deref_def->second.def.loc->location_number>
+    if(deref_def.has_value() &&
+       (deref_def->get().is_assignment() ||
+        deref_def->get().is_phi()) &&
+       deref_def->get().loc->location_number>
        symbolic_def.loc->location_number)
     {
       return false;
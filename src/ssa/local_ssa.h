@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_2LS_SSA_LOCAL_SSA_H
 #define CPROVER_2LS_SSA_LOCAL_SSA_H
 
+#include <unordered_map>
+
 #include <util/options.h>
 #include <util/replace_expr.h>
 #include <util/std_expr.h>
@@ -253,6 +255,10 @@ public:
     locationt loc,
     std::list<nodest::const_iterator> &_nodes) const;
 
+  // must be called whenever nodes are erased from or inserted into
+  // the middle of the node list
+  inline void invalidate_node_index() { node_index.valid=false; }
+
   inline locationt get_location(unsigned location_number) const
   {
     location_mapt::const_iterator it=location_map.find(location_number);
@@ -264,6 +270,30 @@ public:
 protected:
   typedef std::map<unsigned, locationt> location_mapt;
   location_mapt location_map;
+
+  // nodes by location number (in the order of the node list),
+  // rebuilt lazily on lookup after being invalidated
+  struct node_indext
+  {
+    typedef std::unordered_map<unsigned, std::vector<nodest::iterator>>
+      mapt;
+    mapt map;
+    bool valid=false;
+
+    node_indext() {}
+    // the iterators refer to the nodes of the original SSA
+    node_indext(const node_indext &) {}
+    node_indext &operator=(const node_indext &)
+    {
+      map.clear();
+      valid=false;
+      return *this;
+    }
+  };
+  mutable node_indext node_index;
+
+  void index_nodes() const;
+
   // build the SSA formulas
   void build_SSA();
 
@@ -288,7 +318,7 @@ protected:
 
   optionalt<ssa_domaint::deft> get_recent_object_alloc_def(
     locationt loc,
-    const ssa_domaint::def_mapt::const_iterator &def) const;
+    const irep_idt &identifier) const;
 };
 
 std::list<exprt> & operator <<
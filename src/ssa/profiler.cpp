@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Profiling of Analysis Phases
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Profiling of Analysis Phases
+
+#include <sstream>
+
+#include "profiler.h"
+
+/// Adds the time of one execution of a phase.
+void profilert::add_time(
+  const std::string &phase,
+  const irep_idt &function_name,
+  double seconds)
+{
+  entryt &entry=entries[phase][function_name];
+  entry.time+=seconds;
+  entry.count++;
+}
+
+void profilert::add_count(
+  const std::string &counter,
+  const irep_idt &function_name,
+  std::size_t count)
+{
+  if(!enabled)
+    return;
+  entries[counter][function_name].count+=count;
+}
+
+/// Sets a counter that is maintained elsewhere (e.g. solver calls).
+void profilert::set_count(
+  const std::string &counter,
+  const irep_idt &function_name,
+  std::size_t count)
+{
+  if(!enabled)
+    return;
+  entries[counter][function_name].count=count;
+}
+
+/// \return for each phase (or counter) the total and the per-function
+///   times (in seconds) and counts
+json_objectt profilert::to_json() const
+{
+  json_objectt result;
+  for(const auto &phase : entries)
+  {
+    json_objectt json_phase;
+    json_objectt json_functions;
+    entryt total;
+    for(const auto &function : phase.second)
+    {
+      std::ostringstream time;
+      time << function.second.time;
+      json_objectt json_entry;
+      json_entry["time"]=json_numbert(time.str());
+      json_entry["count"]=json_numbert(std::to_string(function.second.count));
+      json_functions[id2string(function.first)]=std::move(json_entry);
+
+      total.time+=function.second.time;
+      total.count+=function.second.count;
+    }
+    std::ostringstream time;
+    time << total.time;
+    json_phase["time"]=json_numbert(time.str());
+    json_phase["count"]=json_numbert(std::to_string(total.count));
+    json_phase["functions"]=std::move(json_functions);
+    result[phase.first]=std::move(json_phase);
+  }
+  return result;
+}
@@ -0,0 +1,90 @@
+/*******************************************************************\
+
+Module: Profiling of Analysis Phases
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Profiling of Analysis Phases
+
+#ifndef CPROVER_2LS_SSA_PROFILER_H
+#define CPROVER_2LS_SSA_PROFILER_H
+
+#include <chrono> // NOLINT(build/c++11)
+#include <map>
+#include <string>
+
+#include <util/irep.h>
+#include <util/json.h>
+
+/// Collects the run times of the analysis phases and further counters per
+/// function. The times of nested phases are included in the enclosing ones.
+class profilert
+{
+public:
+  static profilert &get()
+  {
+    static profilert profiler;
+    return profiler;
+  }
+
+  bool enabled=false;
+
+  void add_time(
+    const std::string &phase,
+    const irep_idt &function_name,
+    double seconds);
+  void add_count(
+    const std::string &counter,
+    const irep_idt &function_name,
+    std::size_t count);
+  void set_count(
+    const std::string &counter,
+    const irep_idt &function_name,
+    std::size_t count);
+
+  json_objectt to_json() const;
+
+  /// Measures the time of a phase from construction to destruction.
+  class scoped_timert
+  {
+  public:
+    scoped_timert(const std::string &_phase, const irep_idt &_function_name):
+      phase(_phase),
+      function_name(_function_name),
+      enabled(profilert::get().enabled)
+    {
+      if(enabled)
+        start=std::chrono::steady_clock::now();
+    }
+
+    ~scoped_timert()
+    {
+      if(!enabled)
+        return;
+      std::chrono::duration<double> time=
+        std::chrono::steady_clock::now()-start;
+      profilert::get().add_time(phase, function_name, time.count());
+    }
+
+  protected:
+    const std::string phase;
+    const irep_idt function_name;
+    const bool enabled;
+    std::chrono::steady_clock::time_point start;
+  };
+
+protected:
+  struct entryt
+  {
+    double time=0;
+    std::size_t count=0;
+  };
+  typedef std::map<irep_idt, entryt> function_mapt;
+  // phases and counters
+  std::map<std::string, function_mapt> entries;
+};
+
+#endif
@@ -10,3 +10,93 @@ Author: Peter Schrammel
 /// Storage for Function SSAs
 
 #include "ssa_db.h"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <solver/summary_db.h>
+
+/// \return the resident memory of the process in bytes or 0 if unknown
+static std::size_t resident_memory()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size, resident;
+  if(statm >> size >> resident)
+    return resident*sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+
+/// If the resident memory cannot be determined, the limit is considered
+/// exceeded.
+bool ssa_dbt::memory_limit_exceeded() const
+{
+  std::size_t limit=options.get_unsigned_int_option("memory-limit");
+  if(limit==0)
+    return false;
+  std::size_t resident=resident_memory();
+  return resident==0 || resident>limit*1024*1024;
+}
+
+void ssa_dbt::evict_solver(const function_namet &function_name)
+{
+  solverst::iterator it=the_solvers.find(function_name);
+  if(it==the_solvers.end())
+    return;
+
+  evicted_solver_calls[function_name]+=
+    it->second->get_number_of_solver_calls();
+  solver_poolt::get().release(it->second);
+  the_solvers.erase(it);
+  evictions++;
+
+  // the whole SSA has to be given to the next solver
+  store.at(function_name)->unmark_nodes();
+}
+
+void ssa_dbt::enforce_memory_limit(const summary_dbt &summary_db)
+{
+  if(!memory_limit_exceeded())
+    return;
+
+  // The allocator rarely returns freed memory to the system, hence the
+  // resident memory hardly drops by evicting solvers. It is therefore not
+  // checked after each eviction, all evictable solvers are evicted instead.
+  // Once the limit has been exceeded, this happens at every check.
+  solver_poolt::get().clear();
+
+  std::vector<function_namet> evictable;
+  for(const auto &solver : the_solvers)
+  {
+    if(summary_db.exists(solver.first) &&
+       !summary_db.get(solver.first).mark_recompute)
+      evictable.push_back(solver.first);
+  }
+
+  for(const auto &function_name : evictable)
+  {
+    evict_solver(function_name);
+    // the released solver is deallocated to free its memory
+    solver_poolt::get().clear(solver_namespaces.at(function_name));
+  }
+
+  debug() << "Evicted " << evictions << " solvers, "
+          << the_solvers.size() << " resident" << eom;
+}
+
+unsigned ssa_dbt::get_number_of_solver_calls(
+  const function_namet &function_name) const
+{
+  unsigned calls=0;
+  solverst::const_iterator it=the_solvers.find(function_name);
+  if(it!=the_solvers.end())
+    calls+=it->second->get_number_of_solver_calls();
+  auto e_it=evicted_solver_calls.find(function_name);
+  if(e_it!=evicted_solver_calls.end())
+    calls+=e_it->second;
+  return calls;
+}
@@ -16,14 +16,18 @@ Author: Peter Schrammel
 
 #include <ssa/unwindable_local_ssa.h>
 #include <domains/incremental_solver.h>
+#include <domains/solver_pool.h>
 #include <goto-programs/goto_functions.h>
 
+class summary_dbt;
+
 class ssa_dbt:public messaget
 {
 public:
   typedef irep_idt function_namet;
   typedef std::map<function_namet, unwindable_local_SSAt*> functionst;
   typedef std::map<function_namet, incremental_solvert*> solverst;
+  typedef std::map<function_namet, namespacet> namespacest;
 
   explicit ssa_dbt(const optionst &_options):
     options(_options)
@@ -33,9 +37,16 @@ public:
   ~ssa_dbt()
   {
     for(auto &item : store)
+    {
+      // the inner solvers of the ranking domains refer to the SSA namespace
+      solver_poolt::get().clear(item.second->ns);
       delete item.second;
+    }
     for(auto &item : the_solvers)
       delete item.second;
+    // the pooled solvers refer to the namespaces
+    for(auto &item : solver_namespaces)
+      solver_poolt::get().clear(item.second);
   }
 
   inline local_SSAt &get(const function_namet &function_name) const
@@ -48,12 +59,23 @@ public:
     solverst::iterator it=the_solvers.find(function_name);
     if(it!=the_solvers.end())
       return *(it->second);
-
+    if(evicted_solver_calls.count(function_name))
+      rebuilds++;
+
+    // The solver keeps a reference to the namespace, hence it must not be
+    // tied to the SSA which may be replaced when unwinding.
+    namespacest::iterator ns_it=
+      solver_namespaces.emplace(function_name, store.at(function_name)->ns)
+        .first;
     the_solvers[function_name]=
-      incremental_solvert::allocate(
-        store.at(function_name)->ns,
+      solver_poolt::get().acquire(
+        ns_it->second,
         get_message_handler(),
-        options.get_bool_option("refine"));
+        options.get_bool_option("refine"),
+        options.get_option("sat-solver"));
+    // the OMT solver is given the formula as expressions
+    if(options.is_set("omt-solver"))
+      the_solvers[function_name]->record_constraints=true;
     return *the_solvers.at(function_name);
   }
 
@@ -65,15 +87,19 @@ public:
     return store.find(function_name)!=store.end();
   }
 
-  inline void clear_solver(const function_namet &function_name)
-  {
-    solverst::iterator it=the_solvers.find(function_name);
-    if(it!=the_solvers.end())
-    {
-      delete it->second;
-      the_solvers.erase(it);
-    }
-  }
+  /// Releases the solver of the function to the solver pool. Its SSA is
+  /// given again to the solver that is acquired on the next access.
+  void evict_solver(const function_namet &function_name);
+
+  /// With --memory-limit, evicts the solvers of all functions whose
+  /// summaries are final if the resident memory exceeds the limit. No solver
+  /// returned by get_solver may be in use when this is called.
+  void enforce_memory_limit(const summary_dbt &summary_db);
+
+  /// \return the number of calls of the current and the evicted solvers of
+  ///   the function
+  unsigned get_number_of_solver_calls(
+    const function_namet &function_name) const;
 
   inline void create(
     const function_namet &function_name,
@@ -83,7 +109,17 @@ public:
   {
     // Avoid memory leaks if overriding
     if(store.count(function_name))
+    {
+      // the inner solvers of the ranking domains refer to the SSA namespace
+      solver_poolt::get().clear(store[function_name]->ns);
       delete store[function_name];
+      // The solver of the function is kept since the constraints of the
+      // previous SSA are disabled, but the pooled solvers are not reused
+      // for the new SSA.
+      namespacest::iterator ns_it=solver_namespaces.find(function_name);
+      if(ns_it!=solver_namespaces.end())
+        solver_poolt::get().clear(ns_it->second);
+    }
     store[function_name]=
       new unwindable_local_SSAt(
         function_name,
@@ -93,10 +129,19 @@ public:
         options);
   }
 
+  // statistics
+  unsigned evictions=0;
+  unsigned rebuilds=0;
+
 protected:
   const optionst &options;
   functionst store;
   solverst the_solvers;
+  namespacest solver_namespaces;
+
+  std::map<function_namet, unsigned> evicted_solver_calls;
+
+  bool memory_limit_exceeded() const;
 };
 
 #endif
@@ -24,12 +24,16 @@ void ssa_domaint::output(
   const ai_baset &,
   const namespacet &ns) const
 {
-  for(def_mapt::const_iterator
-      d_it=def_map.begin();
-      d_it!=def_map.end();
-      d_it++)
+  std::map<irep_idt, const deft *> sorted_defs;
+  def_map.iterate(
+    [&sorted_defs](const irep_idt &id, const deft &def)
+    {
+      sorted_defs[id]=&def;
+    });
+  for(const auto &def : sorted_defs)
   {
-    out << "DEF " << d_it->first << ": " << d_it->second << "\n";
+    out << "DEF " << def.first << ": " << *def.second
+        << " from " << get_source(def.first)->location_number << "\n";
   }
 
   for(phi_nodest::const_iterator
@@ -76,22 +80,21 @@ void ssa_domaint::transform(
       {
         // the second part excluded cases
         // when a result of malloc is at the right-handed side
-        const auto object_ai_it=
-          static_cast<ssa_ait &>(ai)[from].def_map.find(o_it->get_identifier());
-        if(object_ai_it!=static_cast<ssa_ait &>(ai)[from].def_map.end() &&
-           object_ai_it->second.def.is_assignment())
+        const def_mapt &from_def_map=static_cast<ssa_ait &>(ai)[from].def_map;
+        const auto object_def=from_def_map.find(o_it->get_identifier());
+        if(object_def.has_value() &&
+           object_def->get().is_assignment())
         {
           const exprt pointer=
             get_pointer(
               o_it->get_root_object(),
               pointed_level(o_it->get_root_object())-1);
           const auto def_pointer=
-            static_cast<ssa_ait &>(ai)[from]
-              .def_map.find(
-                ssa_objectt(pointer, ns).get_identifier())->second.def;
+            from_def_map.find(
+              ssa_objectt(pointer, ns).get_identifier())->get();
           if(!def_pointer.is_assignment() ||
              def_pointer.loc->location_number<
-               object_ai_it->second.def.loc->location_number)
+               object_def->get().loc->location_number)
           {
             continue;
           }
@@ -99,29 +102,38 @@ void ssa_domaint::transform(
       }
       irep_idt identifier=o_it->get_identifier();
 
-      def_entryt &def_entry=def_map[identifier];
-      def_entry.def.loc=from;
-      def_entry.source=from;
       auto guard_it=assignments.alloc_guards_map.find({from, *o_it});
-      if(guard_it!=assignments.alloc_guards_map.end())
+      auto assign_def=[&from, &guard_it, &assignments](deft &def)
       {
-        def_entry.def.kind=deft::ALLOCATION;
-        def_entry.def.guard=guard_it->second;
-      }
+        def.loc=from;
+        if(guard_it!=assignments.alloc_guards_map.end())
+        {
+          def.kind=deft::ALLOCATION;
+          def.guard=guard_it->second;
+        }
+        else
+          def.kind=deft::ASSIGNMENT;
+      };
+      if(def_map.has_key(identifier))
+        def_map.update(identifier, assign_def);
       else
-        def_entry.def.kind=deft::ASSIGNMENT;
+      {
+        deft def;
+        assign_def(def);
+        def_map.insert(identifier, def);
+      }
     }
   }
   else if(from->is_dead())
   {
     const irep_idt &id=from->dead_symbol().get_identifier();
-    def_map.erase(id);
+    if(def_map.has_key(id))
+      def_map.erase(id);
   }
 
   // update source in all defs
-  for(def_mapt::iterator
-      d_it=def_map.begin(); d_it!=def_map.end(); d_it++)
-    d_it->second.source=from;
+  default_source=from;
+  sources.clear();
 }
 
 bool ssa_domaint::merge(
@@ -129,62 +141,78 @@ bool ssa_domaint::merge(
   trace_ptrt trace_from,
   trace_ptrt trace_to)
 {
+  locationt from{trace_from->current_location()};
   locationt to{trace_to->current_location()};
 
   bool result=has_values.is_false() && !b.has_values.is_false();
 
-  // should traverse both maps simultaneously
-  for(def_mapt::const_iterator
-      d_it_b=b.def_map.begin();
-      d_it_b!=b.def_map.end();
-      d_it_b++)
+  // The state of 'to' has not been reached yet, all definitions are taken
+  // from 'b' and share its entries.
+  if(def_map.empty() && phi_nodes.empty())
+  {
+    def_map=b.def_map;
+    default_source=from;
+    sources.clear();
+    return result || !def_map.empty();
+  }
+
+  // All definitions in 'b' come from 'from'. If we already have a phi node
+  // for an identifier, simply add the definition to the existing phi node.
+  // This doesn't get propagated, don't set result to 'true'.
+  for(auto &phi_node : phi_nodes)
   {
-    const irep_idt &id=d_it_b->first;
+    const auto def_b=b.def_map.find(phi_node.first);
+    if(def_b.has_value())
+      phi_node.second[from->location_number]=def_b->get().def;
+  }
 
-    // check if we have a phi node for 'id'
+  // Entries shared with 'b' have the same definitions, only the differing
+  // ones need to be visited.
+  def_mapt::delta_viewt delta_view;
+  b.def_map.get_delta_view(def_map, delta_view, false);
 
-    phi_nodest::iterator p_it=phi_nodes.find(id);
-    if(p_it!=phi_nodes.end())
-    {
-      // yes, simply add to existing phi node
-      loc_def_mapt &phi_node=p_it->second;
-      phi_node[d_it_b->second.source->location_number]=d_it_b->second.def;
-      // doesn't get propagated, don't set result to 'true'
+  for(const auto &delta_item : delta_view)
+  {
+    const irep_idt &id=delta_item.k;
+    const deft &def_b=delta_item.m;
+
+    if(phi_nodes.find(id)!=phi_nodes.end())
       continue;
-    }
 
     // have we seen this variable yet?
-    def_mapt::iterator d_it_a=def_map.find(id);
-    if(d_it_a==def_map.end())
+    if(!delta_item.is_in_both_maps())
     {
       // no entry in 'this' yet, simply create a new entry
-      def_map[id]=d_it_b->second;
+      def_map.insert(id, def_b);
+      set_source(id, from);
       result=true;
 
       #ifdef DEBUG
-      std::cout << "SETTING " << id << ": " << def_map[id] << "\n";
+      std::cout << "SETTING " << id << ": " << def_b << "\n";
       #endif
       continue;
     }
 
     // we have two entries, compare
-    if(d_it_a->second.def==d_it_b->second.def)
+    const deft &def_a=delta_item.get_other_map_value();
+    if(def_a==def_b)
     {
       #ifdef DEBUG
-      std::cout << "AGREE " << id << ": " << d_it_b->second << "\n";
+      std::cout << "AGREE " << id << ": " << def_b << "\n";
       #endif
       continue;
     }
 
     // Different definitions. Are they coming from the same source?
-    if(d_it_a->second.source==d_it_b->second.source)
+    locationt source_a=get_source(id);
+    if(source_a==from)
     {
       // Propagate the new definition for same source.
-      d_it_a->second.def=d_it_b->second.def;
+      def_map.replace(id, def_b);
       result=true;
 
       #ifdef DEBUG
-      std::cout << "OVERWRITING " << id << ": " << def_map[id] << "\n";
+      std::cout << "OVERWRITING " << id << ": " << def_b << "\n";
       #endif
     }
     else
@@ -193,18 +221,20 @@ bool ssa_domaint::merge(
       // We produce a new phi node.
       loc_def_mapt &phi_node=phi_nodes[id];
 
-      phi_node[d_it_a->second.source->location_number]=d_it_a->second.def;
-      phi_node[d_it_b->second.source->location_number]=d_it_b->second.def;
+      phi_node[source_a->location_number]=def_a;
+      phi_node[from->location_number]=def_b;
 
       // This phi node is now the new source.
-      d_it_a->second.def.loc=to;
-      d_it_a->second.def.kind=deft::PHI;
-      d_it_a->second.source=to;
+      deft phi_def=def_a;
+      phi_def.loc=to;
+      phi_def.kind=deft::PHI;
+      def_map.replace(id, phi_def);
+      set_source(id, to);
 
       result=true;
 
       #ifdef DEBUG
-      std::cout << "MERGING " << id << ": " << d_it_b->second << "\n";
+      std::cout << "MERGING " << id << ": " << def_b << "\n";
       #endif
     }
   }
@@ -243,15 +273,16 @@ void ssa_ait::initialize(
     }
     #endif
 
+    entry.default_source=e;
     for(ssa_objectst::objectst::const_iterator
         o_it=assignments.ssa_objects.objects.begin();
         o_it!=assignments.ssa_objects.objects.end();
         o_it++)
     {
-      irep_idt id=o_it->get_identifier();
-      entry.def_map[id].source=e;
-      entry.def_map[id].def.loc=e;
-      entry.def_map[id].def.kind=ssa_domaint::deft::INPUT;
+      ssa_domaint::deft def;
+      def.loc=e;
+      def.kind=ssa_domaint::deft::INPUT;
+      entry.def_map.insert(o_it->get_identifier(), def);
     }
   }
 }
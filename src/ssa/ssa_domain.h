@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_2LS_SSA_SSA_DOMAIN_H
 
 #include <analyses/ai.h>
+#include <util/sharing_map.h>
 #include <util/threeval.h>
 
 #include "assignments.h"
@@ -55,22 +56,30 @@ public:
     return out;
   }
 
-  // definition and source for an identifier
-  struct def_entryt
-  {
-    def_entryt() { }
-    deft def;
-    locationt source; // information from?
-  };
+  // Shared between the states of all locations, only entries that differ
+  // are stored separately.
+  typedef sharing_mapt<irep_idt, deft> def_mapt;
+  def_mapt def_map;
 
-  friend inline std::ostream & operator << (
-    std::ostream &out, const def_entryt &d)
+  // The source of a definition is the location it comes from (the location
+  // of the state itself for phi nodes). The sources are kept outside of
+  // def_map to keep its entries shared: all definitions come from
+  // default_source except for those in sources.
+  locationt default_source;
+  std::map<irep_idt, locationt> sources;
+
+  locationt get_source(const irep_idt &identifier) const
   {
-    return out << d.def << " from " << d.source->location_number;
+    const auto it=sources.find(identifier);
+    return it==sources.end() ? default_source : it->second;
+  }
+  void set_source(const irep_idt &identifier, locationt source)
+  {
+    if(source==default_source)
+      sources.erase(identifier);
+    else
+      sources[identifier]=source;
   }
-
-  typedef std::map<irep_idt, def_entryt> def_mapt;
-  def_mapt def_map;
 
   // The phi nodes map identifiers to incoming branches:
   // map from source to definition.
@@ -100,12 +109,14 @@ public:
   {
     phi_nodes.clear();
     def_map.clear();
+    sources.clear();
     has_values=tvt(false);
   }
   void make_top() override
   {
     phi_nodes.clear();
     def_map.clear();
+    sources.clear();
     has_values=tvt(true);
   }
   void make_entry() override
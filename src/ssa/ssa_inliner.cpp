@@ -202,7 +202,8 @@ void ssa_inlinert::replace(
         debug() << "No summary available for function " << fname << eom;
       commit_node(n_it);
     }
-    commit_nodes(SSA.nodes, n_it);
+    if(!commit_nodes(SSA.nodes, n_it))
+      SSA.invalidate_node_index();
   }
 }
 
@@ -676,13 +677,42 @@ void ssa_inlinert::havoc(
   rm_function_calls.insert(f_it);
 }
 
+/// Renames the symbols in the expression to the current call site by
+/// appending "@counter" to their identifiers. Addresses of objects are
+/// replaced by renamed address symbols. Subexpressions that do not change
+/// are not copied, hence they remain shared with the original expression.
 void ssa_inlinert::rename(exprt &expr)
+{
+  if(rename_cache_counter!=counter || rename_suffix.empty())
+  {
+    rename_cache_counter=counter;
+    rename_suffix="@"+std::to_string(counter);
+    renamed_identifiers.clear();
+    renamed_exprs.clear();
+  }
+
+  optionalt<exprt> renamed=rename_rec(expr);
+  if(renamed.has_value())
+    expr=std::move(*renamed);
+}
+
+const irep_idt &ssa_inlinert::renamed_identifier(const irep_idt &identifier)
+{
+  auto entry=renamed_identifiers.emplace(identifier, irep_idt());
+  if(entry.second)
+    entry.first->second=id2string(identifier)+rename_suffix;
+  return entry.first->second;
+}
+
+/// \return the renamed expression, or an empty value if the expression does
+///   not contain anything to rename
+optionalt<exprt> ssa_inlinert::rename_rec(const exprt &expr)
 {
   if(expr.id()==ID_symbol)
   {
-    symbol_exprt &sexpr=to_symbol_expr(expr);
-    irep_idt id=id2string(sexpr.get_identifier())+"@"+std::to_string(counter);
-    sexpr.set_identifier(id);
+    symbol_exprt sexpr=to_symbol_expr(expr);
+    sexpr.set_identifier(renamed_identifier(sexpr.get_identifier()));
+    return std::move(sexpr);
   }
   else if(expr.id()==ID_address_of)
   {
@@ -690,19 +720,36 @@ void ssa_inlinert::rename(exprt &expr)
     const exprt &obj=to_address_of_expr(expr).object();
     if(obj.id()==ID_symbol)
     {
-      const std::string &obj_id=id2string(to_symbol_expr(obj).get_identifier());
       if(is_pointed(obj))
         id=get_pointer_id(obj);
       else
-        id=id2string(obj_id)+"'addr";
+        id=id2string(to_symbol_expr(obj).get_identifier())+"'addr";
 
-      id=id2string(id)+"@"+std::to_string(counter);
+      id=renamed_identifier(id);
     }
-    symbol_exprt addr_symbol(id, expr.type());
-    expr=addr_symbol;
+    return symbol_exprt(id, expr.type());
+  }
+
+  if(!expr.has_operands())
+    return {};
+
+  auto cached=renamed_exprs.find(expr);
+  if(cached!=renamed_exprs.end())
+    return cached->second;
+
+  optionalt<exprt> result;
+  for(std::size_t i=0; i<expr.operands().size(); i++)
+  {
+    optionalt<exprt> op=rename_rec(expr.operands()[i]);
+    if(!op.has_value())
+      continue;
+    if(!result.has_value())
+      result=expr;
+    result->operands()[i]=std::move(*op);
   }
-  Forall_operands(op, expr)
-    rename(*op);
+
+  renamed_exprs.emplace(expr, result);
+  return result;
 }
 
 void ssa_inlinert::rename(local_SSAt::nodet &node)
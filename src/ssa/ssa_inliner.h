@@ -12,6 +12,8 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_SSA_SSA_INLINER_H
 #define CPROVER_2LS_SSA_SSA_INLINER_H
 
+#include <unordered_map>
+
 #include <util/message.h>
 
 #include <solver/summary.h>
@@ -25,7 +27,8 @@ class ssa_inlinert:public messaget
 public:
   explicit ssa_inlinert(summary_dbt &_summary_db):
     counter(0),
-    summary_db(_summary_db)
+    summary_db(_summary_db),
+    rename_cache_counter(0)
   {
   }
 
@@ -147,6 +150,17 @@ protected:
   void rename(exprt &expr);
   void rename(local_SSAt::nodet &node);
 
+  // Caches of the renaming for the current counter. Renamed identifiers are
+  // computed once per identifier and renamed subexpressions once per
+  // distinct subexpression, which are frequently shared in summaries.
+  unsigned rename_cache_counter;
+  std::string rename_suffix;
+  std::unordered_map<irep_idt, irep_idt> renamed_identifiers;
+  std::unordered_map<exprt, optionalt<exprt>, irep_hash> renamed_exprs;
+
+  const irep_idt &renamed_identifier(const irep_idt &identifier);
+  optionalt<exprt> rename_rec(const exprt &expr);
+
   bool cs_heap_covered(const exprt &expr);
 
   // Transformation functions for lists of input/output arguments/pointers
@@ -91,6 +91,7 @@ void ssa_local_unwindert::build_loop_tree()
     else
       --n_it;
   }
+  SSA.invalidate_node_index();
 }
 
 /// find variables at loop head and backedge
@@ -244,6 +245,7 @@ void ssa_local_unwindert::unwind(unsigned k)
     unwind(it->second, k, false); // recursive
     assert(SSA.current_unwindings.empty());
   }
+  SSA.invalidate_node_index();
   // update current unwinding
   current_unwinding=k;
 }
@@ -46,6 +46,8 @@ public:
     const local_SSAt::nodet &node,
     bool pre) const override;
 
+  bool is_unwinding_dependent() const override { return !loops.empty(); }
+
 protected:
   class loopt // loop tree
   {
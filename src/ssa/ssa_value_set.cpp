@@ -137,7 +137,7 @@ void ssa_value_domaint::transform(
       for(const symbol_exprt &o2 : objects)
       {
         if(o1!=o2 && o1.type()==o2.type())
-          value_map[ssa_objectt(o1, ns)].value_set.insert(ssa_objectt(o2, ns));
+          add_value(ssa_objectt(o1, ns), ssa_objectt(o2, ns));
       }
     }
   }
@@ -202,15 +202,18 @@ void ssa_value_domaint::assign_lhs_rec(
       assign_pointed_rhs_rec(rhs, ns);
 #endif
 
-      valuest tmp_values;
-      assign_rhs_rec(tmp_values, rhs, ns, false, 0);
+      valuest lhs_values;
+      assign_rhs_rec(lhs_values, rhs, ns, false, 0);
 
-      valuest &lhs_values=value_map[ssa_object];
+      const auto old_values=value_map.find(ssa_object);
+      const bool has_old_values=old_values.has_value();
 
-      if(add)
+      if(add && has_old_values)
+      {
+        valuest tmp_values=lhs_values;
+        lhs_values=old_values->get();
         lhs_values.merge(tmp_values);
-      else
-        lhs_values=tmp_values;
+      }
 
 #if 0
       std::cout << "value_set: ";
@@ -219,7 +222,14 @@ void ssa_value_domaint::assign_lhs_rec(
 #endif
 
       if(lhs_values.empty())
-        value_map.erase(ssa_object);
+      {
+        if(has_old_values)
+          value_map.erase(ssa_object);
+      }
+      else if(has_old_values)
+        value_map.replace(ssa_object, lhs_values);
+      else
+        value_map.insert(ssa_object, lhs_values);
     }
 
     return; // done
@@ -363,11 +373,11 @@ void ssa_value_domaint::assign_rhs_rec(
 
     if(ssa_object)
     {
-      value_mapt::const_iterator m_it=value_map.find(ssa_object);
+      const auto values=value_map.find(ssa_object);
 
-      if(m_it!=value_map.end())
+      if(values.has_value())
       {
-        valuest tmp_values=m_it->second;
+        valuest tmp_values=values->get();
         if(offset)
           tmp_values.offset=true;
         tmp_values.alignment=merge_alignment(tmp_values.alignment, alignment);
@@ -455,13 +465,16 @@ void ssa_value_domaint::output(
   const ai_baset &ai,
   const namespacet &ns) const
 {
-  for(value_mapt::const_iterator
-        v_it=value_map.begin();
-      v_it!=value_map.end();
-      v_it++)
+  std::map<ssa_objectt, const valuest *> sorted_values;
+  value_map.iterate(
+    [&sorted_values](const ssa_objectt &object, const valuest &values)
+    {
+      sorted_values[object]=&values;
+    });
+  for(const auto &values : sorted_values)
   {
-    out << v_it->first.get_identifier() << ':';
-    v_it->second.output(out, ns);
+    out << values.first.get_identifier() << ':';
+    values.second->output(out, ns);
     out << '\n';
   }
 }
@@ -548,37 +561,42 @@ bool ssa_value_domaint::merge(
 {
   locationt from{trace_from->current_location()};
 
-  value_mapt::iterator v_it=value_map.begin();
-  const value_mapt &new_value_map=other.value_map;
   bool result=has_values.is_false() && !other.has_values.is_false();
+
+  // nothing to merge with, the entries of 'other' are shared
+  if(has_values.is_false())
+  {
+    value_map=other.value_map;
+    has_values=tvt::unknown();
+    competition_mode=competition_mode || other.competition_mode;
+    return result || !value_map.empty();
+  }
   has_values=tvt::unknown();
 
-  for(value_mapt::const_iterator
-        it=new_value_map.begin();
-      it!=new_value_map.end();
-    ) // no it++
+  // entries shared with 'other' are equal, only the differing ones need to
+  // be merged
+  value_mapt::delta_viewt delta_view;
+  other.value_map.get_delta_view(value_map, delta_view, false);
+
+  for(const auto &delta_item : delta_view)
   {
-    if(v_it==value_map.end() || it->first<v_it->first)
+    if(!delta_item.is_in_both_maps())
     {
-      value_map.insert(v_it, *it);
+      value_map.insert(delta_item.k, delta_item.m);
       result=true;
-      it++;
-      continue;
-    }
-    else if(v_it->first<it->first)
-    {
-      v_it++;
       continue;
     }
 
-    assert(v_it->first==it->first);
-
-    if(v_it->second.merge(it->second, from->is_backwards_goto(),
-                          it->first.get_identifier()))
+    const valuest &old_values=delta_item.get_other_map_value();
+    valuest values=old_values;
+    bool changed=values.merge(
+      delta_item.m,
+      from->is_backwards_goto(),
+      delta_item.k.get_identifier());
+    if(changed || values.alignment!=old_values.alignment)
+      value_map.replace(delta_item.k, values);
+    if(changed)
       result=true;
-
-    v_it++;
-    it++;
   }
 
   competition_mode=competition_mode || other.competition_mode;
@@ -586,6 +604,30 @@ bool ssa_value_domaint::merge(
   return result;
 }
 
+/// Adds the object value to the value set of the object.
+void ssa_value_domaint::add_value(
+  const ssa_objectt &object,
+  const ssa_objectt &value)
+{
+  const auto values=value_map.find(object);
+  if(!values.has_value())
+  {
+    valuest new_values;
+    new_values.value_set.insert(value);
+    value_map.insert(object, new_values);
+  }
+  else if(values->get().value_set.find(value)==
+          values->get().value_set.end())
+  {
+    value_map.update(
+      object,
+      [&value](valuest &values)
+      {
+        values.value_set.insert(value);
+      });
+  }
+}
+
 /// Dynamically add p'obj to value set of p
 void ssa_value_domaint::assign_pointed_rhs_rec(
   const exprt &rhs,
@@ -598,13 +640,11 @@ void ssa_value_domaint::assign_pointed_rhs_rec(
     if(ssa_object.get_root_object().get_bool("#unknown_obj"))
       return;
 
-    value_mapt::const_iterator m_it=value_map.find(ssa_object);
-
-    if(m_it==value_map.end())
+    if(!value_map.has_key(ssa_object))
     {
       const symbol_exprt pointed=pointed_object(rhs, ns);
       ssa_objectt pointed_obj(pointed, ns);
-      value_map[ssa_object].value_set.insert(pointed_obj);
+      add_value(ssa_object, pointed_obj);
     }
   }
   else
@@ -688,6 +728,6 @@ void ssa_value_ait::assign(
   ssa_objectt dest_obj(dest, ns);
   if(src_obj && dest_obj)
   {
-    entry.value_map[src_obj].value_set.insert(dest_obj);
+    entry.add_value(src_obj, dest_obj);
   }
 }
@@ -14,9 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/ai.h>
 #include <util/options.h>
+#include <util/sharing_map.h>
 #include <util/threeval.h>
 
 #include "ssa_object.h"
+#include "profiler.h"
 
 class ssa_value_domaint:public ai_domain_baset
 {
@@ -98,10 +100,21 @@ public:
     }
   };
 
-  // maps objects to values
-  typedef std::map<ssa_objectt, valuest> value_mapt;
+  struct ssa_object_hasht
+  {
+    std::size_t operator()(const ssa_objectt &object) const
+    {
+      return std::hash<irep_idt>()(object.get_identifier());
+    }
+  };
+
+  // maps objects to values, shared between the states of all locations
+  typedef sharing_mapt<ssa_objectt, valuest, false, ssa_object_hasht>
+    value_mapt;
   value_mapt value_map;
 
+  void add_value(const ssa_objectt &object, const ssa_objectt &value);
+
   bool competition_mode=false;
 
   const valuest operator()(
@@ -162,6 +175,7 @@ public:
     ns(ns_),
     options(_options)
   {
+    profilert::scoped_timert timer("value_analysis", function_identifier);
     operator()(function_identifier, goto_function, ns_);
   }
 
@@ -56,6 +56,10 @@ public:
     const local_SSAt::nodet &node,
     bool pre) const=0;
 
+  /// Tells whether unwinding to a higher bound changes the SSA of the
+  /// function, i.e. whether the summary of the function must be recomputed.
+  virtual bool is_unwinding_dependent() const=0;
+
   /// The bound up to which loops are currently unwound.
   long current_unwinding=-1;
 };